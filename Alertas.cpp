@@ -0,0 +1,163 @@
+/**
+ * @file Alertas.cpp
+ * @brief Implementación del motor de alertas y su cola.
+ */
+
+#include "Alertas.h"
+
+// --- Implementación ColaAlertas ---
+bool ColaAlertas::encolar(const Alerta& a) {
+    uint32_t c = cola.load(std::memory_order_relaxed);
+    if (c - cabeza.load(std::memory_order_acquire) == CAPACIDAD) {
+        perdidas.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    alertas[c & (CAPACIDAD - 1)] = a;
+    cola.store(c + 1, std::memory_order_release);
+    return true;
+}
+
+bool ColaAlertas::desencolar(Alerta& a) {
+    uint32_t h = cabeza.load(std::memory_order_relaxed);
+    if (h == cola.load(std::memory_order_acquire)) return false;
+    a = alertas[h & (CAPACIDAD - 1)];
+    cabeza.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+
+// --- Implementación MotorAlertas ---
+MotorAlertas::MotorAlertas() : tabla(nullptr), capacidad(0), callback(nullptr), contexto(nullptr) {
+    for (int t = 0; t < NUM_TIPOS_SENSOR; t++) {
+        hayReglaTipo[t] = false;
+    }
+}
+
+MotorAlertas::~MotorAlertas() {
+    delete[] tabla;
+}
+
+void MotorAlertas::compilarDesdeTipo(Entrada& e) {
+    if (e.origen == REGLA_DE_SENSOR) return;
+    if (hayReglaTipo[e.tipo]) {
+        e.regla = reglasTipo[e.tipo];
+        e.origen = REGLA_DE_TIPO;
+    } else {
+        e.regla = ReglaAlerta();
+        e.origen = SIN_REGLA;
+    }
+    e.disparadas = 0;
+}
+
+void MotorAlertas::asignarRanura(int ranura, TipoSensor tipo) {
+    if (ranura >= capacidad) {
+        int nuevaCapacidad = (capacidad == 0) ? RegistroSensores::CELDAS_POR_BLOQUE : capacidad;
+        while (nuevaCapacidad <= ranura) nuevaCapacidad *= 2;
+        Entrada* nuevaTabla = new Entrada[nuevaCapacidad];
+        for (int i = 0; i < capacidad; i++) nuevaTabla[i] = tabla[i];
+        delete[] tabla;
+        tabla = nuevaTabla;
+        capacidad = nuevaCapacidad;
+    }
+    Entrada& e = tabla[ranura];
+    e = Entrada();
+    e.tipo = (uint8_t)tipo;
+    compilarDesdeTipo(e);
+}
+
+void MotorAlertas::liberarRanura(int ranura) {
+    if (ranura < capacidad) {
+        tabla[ranura] = Entrada();
+    }
+}
+
+void MotorAlertas::definirReglaTipo(TipoSensor tipo, const ReglaAlerta& regla) {
+    reglasTipo[tipo] = regla;
+    hayReglaTipo[tipo] = true;
+    for (int i = 0; i < capacidad; i++) {
+        if (tabla[i].tipo == tipo) compilarDesdeTipo(tabla[i]);
+    }
+}
+
+void MotorAlertas::definirReglaSensor(int ranura, const ReglaAlerta& regla) {
+    if (ranura >= capacidad) return;
+    tabla[ranura].regla = regla;
+    tabla[ranura].origen = REGLA_DE_SENSOR;
+    tabla[ranura].disparadas = 0;
+}
+
+void MotorAlertas::quitarReglaSensor(int ranura) {
+    if (ranura >= capacidad) return;
+    tabla[ranura].origen = SIN_REGLA;
+    compilarDesdeTipo(tabla[ranura]);
+}
+
+void MotorAlertas::configurarCallback(CallbackAlerta cb, void* ctx) {
+    callback = cb;
+    contexto = ctx;
+}
+
+void MotorAlertas::emitir(ManejadorSensor h, TipoAlerta tipo, float valor, float limite, MarcaTiempo tiempo) {
+    Alerta a;
+    a.sensor = h;
+    a.tipo = tipo;
+    a.valor = valor;
+    a.limite = limite;
+    a.tiempo = tiempo;
+    if (callback != nullptr) callback(a, contexto);
+    cola.encolar(a);
+}
+
+int MotorAlertas::evaluar(ManejadorSensor h, float valor, MarcaTiempo tiempo) {
+    if ((int)h.indice >= capacidad) return 0;
+    Entrada& e = tabla[h.indice];
+    if (e.origen == SIN_REGLA) return 0;
+
+    const ReglaAlerta& r = e.regla;
+    int emitidas = 0;
+
+    // Umbrales por flanco, con histéresis para rearmar
+    if (valor > r.maximo) {
+        if (!(e.disparadas & DISPARO_MAXIMO)) {
+            e.disparadas |= DISPARO_MAXIMO;
+            emitir(h, ALERTA_MAXIMO, valor, r.maximo, tiempo);
+            emitidas++;
+        }
+    } else if (valor <= r.maximo - r.histeresis) {
+        e.disparadas &= ~DISPARO_MAXIMO;
+    }
+
+    if (valor < r.minimo) {
+        if (!(e.disparadas & DISPARO_MINIMO)) {
+            e.disparadas |= DISPARO_MINIMO;
+            emitir(h, ALERTA_MINIMO, valor, r.minimo, tiempo);
+            emitidas++;
+        }
+    } else if (valor >= r.minimo + r.histeresis) {
+        e.disparadas &= ~DISPARO_MINIMO;
+    }
+
+    // Cambio por segundo respecto de la lectura anterior
+    if (r.maxCambioPorSegundo > 0 && e.hayPrevio && tiempo > e.tiempoPrevio) {
+        float cambio = valor - e.previo;
+        if (cambio < 0) cambio = -cambio;
+        float porSegundo = cambio * 1000.0f / (float)(tiempo - e.tiempoPrevio);
+        if (porSegundo > r.maxCambioPorSegundo) {
+            if (!(e.disparadas & DISPARO_CAMBIO)) {
+                e.disparadas |= DISPARO_CAMBIO;
+                emitir(h, ALERTA_CAMBIO_BRUSCO, porSegundo, r.maxCambioPorSegundo, tiempo);
+                emitidas++;
+            }
+        } else {
+            e.disparadas &= ~DISPARO_CAMBIO;
+        }
+    }
+    // Lecturas en el mismo milisegundo no mueven la base del cambio: si no,
+    // un salto seguido de otra lectura en ese milisegundo pasaría inadvertido
+    if (!e.hayPrevio || tiempo > e.tiempoPrevio) {
+        e.previo = valor;
+        e.tiempoPrevio = tiempo;
+        e.hayPrevio = true;
+    }
+    return emitidas;
+}
@@ -0,0 +1,274 @@
+/**
+ * @file Alertas.h
+ * @brief Define el motor de alertas por umbral evaluado al ingresar cada lectura.
+ */
+#ifndef ALERTAS_H
+#define ALERTAS_H
+
+#include "RegistroSensores.h"
+#include <atomic>
+#include <cfloat> // Para FLT_MAX
+#include <stdint.h>
+
+/**
+ * @enum TipoAlerta
+ * @brief Condición que disparó una alerta.
+ */
+enum TipoAlerta {
+    /// @brief La lectura superó el máximo.
+    ALERTA_MAXIMO,
+    /// @brief La lectura quedó por debajo del mínimo.
+    ALERTA_MINIMO,
+    /// @brief La lectura cambió más rápido que lo permitido.
+    ALERTA_CAMBIO_BRUSCO
+};
+
+/**
+ * @struct ReglaAlerta
+ * @brief Umbrales de una regla; los valores por defecto no disparan nunca.
+ * @details Las alertas de umbral son por flanco: se disparan al cruzar el
+ * límite y no se repiten hasta que la lectura vuelve a estar a más de
+ * `histeresis` del límite (ej. máximo 30 con histéresis 1: dispara en
+ * 30.5, se rearma en 29). La de cambio brusco se rearma en cuanto el
+ * cambio por segundo vuelve a estar dentro del límite.
+ */
+struct ReglaAlerta {
+    /// @brief Mínimo permitido (-FLT_MAX = sin mínimo).
+    float minimo;
+    /// @brief Máximo permitido (FLT_MAX = sin máximo).
+    float maximo;
+    /// @brief Cambio máximo por segundo entre lecturas consecutivas (0 = sin regla).
+    float maxCambioPorSegundo;
+    /// @brief Margen para rearmar las alertas de umbral.
+    float histeresis;
+
+    /**
+     * @brief Constructor. Regla sin límites.
+     */
+    ReglaAlerta() : minimo(-FLT_MAX), maximo(FLT_MAX), maxCambioPorSegundo(0), histeresis(0) {}
+};
+
+/**
+ * @struct Alerta
+ * @brief Alerta emitida por el MotorAlertas.
+ */
+struct Alerta {
+    /// @brief Sensor que la originó.
+    ManejadorSensor sensor;
+    /// @brief Condición disparada.
+    TipoAlerta tipo;
+    /// @brief Lectura que la disparó (o cambio por segundo, en ALERTA_CAMBIO_BRUSCO).
+    float valor;
+    /// @brief Límite superado.
+    float limite;
+    /// @brief Marca de tiempo de la lectura.
+    MarcaTiempo tiempo;
+};
+
+/**
+ * @brief Función que recibe las alertas en el momento en que se detectan.
+ * @param alerta La alerta emitida.
+ * @param contexto El puntero registrado junto con la función.
+ */
+typedef void (*CallbackAlerta)(const Alerta& alerta, void* contexto);
+
+/**
+ * @class ColaAlertas
+ * @brief Cola circular de capacidad fija entre un productor y un consumidor.
+ * @details El productor es el hilo de ingreso y el consumidor quien lea las
+ * alertas; cada uno mueve solo su índice, así que no hacen falta locks. Si
+ * la cola está llena la alerta nueva se descarta y se cuenta en `perdidas`.
+ */
+class ColaAlertas {
+public:
+    /// @brief Capacidad (potencia de 2).
+    static const uint32_t CAPACIDAD = 256;
+
+private:
+    /// @brief Alertas encoladas.
+    Alerta alertas[CAPACIDAD];
+    /// @brief Índice de lectura (lo avanza el consumidor).
+    std::atomic<uint32_t> cabeza;
+    /// @brief Índice de escritura (lo avanza el productor).
+    std::atomic<uint32_t> cola;
+    /// @brief Alertas descartadas por cola llena.
+    std::atomic<uint32_t> perdidas;
+
+public:
+    /**
+     * @brief Constructor. Cola vacía.
+     */
+    ColaAlertas() : cabeza(0), cola(0), perdidas(0) {}
+
+    /**
+     * @brief Encola una alerta (productor).
+     * @return false si la cola estaba llena.
+     */
+    bool encolar(const Alerta& a);
+
+    /**
+     * @brief Desencola la alerta más antigua (consumidor).
+     * @return false si la cola estaba vacía.
+     */
+    bool desencolar(Alerta& a);
+
+    /**
+     * @brief Obtiene el número de alertas descartadas por cola llena.
+     */
+    uint32_t getPerdidas() const { return perdidas.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @class MotorAlertas
+ * @brief Evalúa reglas de alerta en O(1) por lectura.
+ * @details Las reglas se definen por tipo de sensor o por sensor (la del
+ * sensor tiene prioridad) y se compilan en una tabla plana indexada por la
+ * ranura del sensor en el RegistroSensores. Cada entrada tiene la regla
+ * vigente y el estado que necesita (flancos disparados, lectura previa),
+ * así que evaluar una lectura es un acceso a la tabla y unas comparaciones.
+ * Las alertas se entregan por callback (en el mismo hilo de ingreso) y
+ * además quedan en una ColaAlertas para consumirlas desde otro hilo.
+ */
+class MotorAlertas {
+private:
+    /// @brief Bits de `disparadas`.
+    enum {
+        DISPARO_MAXIMO = 1,
+        DISPARO_MINIMO = 2,
+        DISPARO_CAMBIO = 4
+    };
+
+    /// @brief Origen de la regla compilada en una entrada.
+    enum {
+        SIN_REGLA = 0,
+        REGLA_DE_TIPO = 1,
+        REGLA_DE_SENSOR = 2
+    };
+
+    /**
+     * @struct Entrada
+     * @brief Regla compilada y estado de una ranura.
+     */
+    struct Entrada {
+        /// @brief Regla vigente para el sensor de la ranura.
+        ReglaAlerta regla;
+        /// @brief Base del cambio por segundo: primera lectura del último milisegundo con datos.
+        float previo;
+        /// @brief Marca de tiempo de `previo`.
+        MarcaTiempo tiempoPrevio;
+        /// @brief Tipo del sensor de la ranura.
+        uint8_t tipo;
+        /// @brief SIN_REGLA, REGLA_DE_TIPO o REGLA_DE_SENSOR.
+        uint8_t origen;
+        /// @brief Alertas de flanco ya disparadas (bits DISPARO_*).
+        uint8_t disparadas;
+        /// @brief true si `previo` es válido.
+        bool hayPrevio;
+
+        /**
+         * @brief Constructor. Entrada de una ranura libre.
+         */
+        Entrada() : previo(0), tiempoPrevio(0), tipo(NUM_TIPOS_SENSOR), origen(SIN_REGLA), disparadas(0), hayPrevio(false) {}
+    };
+
+    /// @brief Tabla indexada por ranura.
+    Entrada* tabla;
+    /// @brief Capacidad de la tabla.
+    int capacidad;
+    /// @brief Regla de cada tipo de sensor.
+    ReglaAlerta reglasTipo[NUM_TIPOS_SENSOR];
+    /// @brief true si el tipo tiene regla definida.
+    bool hayReglaTipo[NUM_TIPOS_SENSOR];
+    /// @brief Función de entrega inmediata (nullptr = solo cola).
+    CallbackAlerta callback;
+    /// @brief Contexto pasado al callback.
+    void* contexto;
+    /// @brief Cola de alertas pendientes de consumir.
+    ColaAlertas cola;
+
+    /**
+     * @brief Compila en la entrada la regla de su tipo (si no tiene una propia).
+     */
+    void compilarDesdeTipo(Entrada& e);
+
+    /**
+     * @brief Entrega una alerta por callback y cola.
+     */
+    void emitir(ManejadorSensor h, TipoAlerta tipo, float valor, float limite, MarcaTiempo tiempo);
+
+public:
+    /**
+     * @brief Constructor. Sin reglas ni callback.
+     */
+    MotorAlertas();
+
+    /**
+     * @brief Destructor. Libera la tabla.
+     */
+    ~MotorAlertas();
+
+    /**
+     * @brief Prepara la entrada de una ranura recién ocupada por un sensor.
+     * @param ranura La ranura en el registro.
+     * @param tipo El tipo del sensor.
+     */
+    void asignarRanura(int ranura, TipoSensor tipo);
+
+    /**
+     * @brief Olvida la regla y el estado de una ranura liberada.
+     */
+    void liberarRanura(int ranura);
+
+    /**
+     * @brief Define la regla de todos los sensores de un tipo (salvo los que tengan regla propia).
+     * @details Recompila las entradas afectadas: O(ranuras), pensado para configuración.
+     */
+    void definirReglaTipo(TipoSensor tipo, const ReglaAlerta& regla);
+
+    /**
+     * @brief Define la regla propia del sensor de una ranura.
+     */
+    void definirReglaSensor(int ranura, const ReglaAlerta& regla);
+
+    /**
+     * @brief Quita la regla propia de una ranura; vuelve a regir la de su tipo.
+     */
+    void quitarReglaSensor(int ranura);
+
+    /**
+     * @brief Registra la función que recibe las alertas al detectarse.
+     * @param cb La función (nullptr para desactivarla).
+     * @param ctx Puntero que se le pasará en cada llamada.
+     */
+    void configurarCallback(CallbackAlerta cb, void* ctx);
+
+    /**
+     * @brief Evalúa una lectura recién ingresada en O(1).
+     * @param h Manejador del sensor (su índice es la ranura).
+     * @param valor La lectura.
+     * @param tiempo Su marca de tiempo.
+     * @return Número de alertas emitidas.
+     */
+    int evaluar(ManejadorSensor h, float valor, MarcaTiempo tiempo);
+
+    /**
+     * @brief Extrae la alerta pendiente más antigua.
+     * @details Toda alerta se encola aunque haya callback, así que alguien
+     * tiene que vaciar la cola (el menú y el Demonio lo hacen en cada
+     * vuelta); si no, al llenarse se descartan y se cuentan como perdidas.
+     * @return false si no hay alertas pendientes.
+     */
+    bool siguienteAlerta(Alerta& a) { return cola.desencolar(a); }
+
+    /**
+     * @brief Obtiene el número de alertas descartadas por cola llena.
+     */
+    uint32_t getAlertasPerdidas() const { return cola.getPerdidas(); }
+
+private:
+    // No copiable.
+    MotorAlertas(const MotorAlertas&);
+    MotorAlertas& operator=(const MotorAlertas&);
+};
+
+#endif
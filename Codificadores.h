@@ -0,0 +1,539 @@
+/**
+ * @file Codificadores.h
+ * @brief Define los flujos de bits y los codificadores de muestras usados por SerieComprimida.
+ * @details Contiene EscritorBits/LectorBits, las especializaciones de
+ * Codificador<T> (decimales escalados con respaldo XOR de Gorilla para
+ * float y delta-de-delta con zigzag + varint para int) y CodificadorTiempos para las marcas de tiempo.
+ */
+#ifndef CODIFICADORES_H
+#define CODIFICADORES_H
+
+#include <stdint.h>
+#include <cstring> // Para memcpy
+
+/**
+ * @class EscritorBits
+ * @brief Escribe valores de ancho arbitrario (MSB primero) sobre un buffer de bytes.
+ * @details El buffer debe estar inicializado en cero; el escritor no lo
+ * reserva ni lo libera, solo avanza la posición en bits.
+ */
+class EscritorBits {
+private:
+    /// @brief Buffer destino (debe tener espacio suficiente y estar en cero).
+    unsigned char* datos;
+    /// @brief Posición actual en bits dentro del buffer.
+    long posBits;
+
+public:
+    /**
+     * @brief Constructor del escritor.
+     * @param buffer Buffer destino.
+     * @param bitsIniciales Posición en bits desde la que se continúa escribiendo.
+     */
+    EscritorBits(unsigned char* buffer, long bitsIniciales) : datos(buffer), posBits(bitsIniciales) {}
+
+    /**
+     * @brief Escribe los `n` bits menos significativos de `valor`.
+     * @param valor El valor a escribir.
+     * @param n Número de bits (0..64).
+     */
+    void escribir(uint64_t valor, int n) {
+        while (n > 0) {
+            int libres = 8 - (int)(posBits & 7);
+            int tomar = (n < libres) ? n : libres;
+            unsigned char trozo = (unsigned char)((valor >> (n - tomar)) & ((1u << tomar) - 1));
+            datos[posBits >> 3] |= (unsigned char)(trozo << (libres - tomar));
+            posBits += tomar;
+            n -= tomar;
+        }
+    }
+
+    /**
+     * @brief Escribe un único bit.
+     */
+    void escribirBit(bool bit) {
+        if (bit) datos[posBits >> 3] |= (unsigned char)(0x80 >> (posBits & 7));
+        posBits++;
+    }
+
+    /**
+     * @brief Escribe un entero sin signo en formato varint (grupos de 7 bits).
+     */
+    void escribirVarint(uint64_t valor) {
+        while (valor >= 0x80) {
+            escribir((valor & 0x7F) | 0x80, 8);
+            valor >>= 7;
+        }
+        escribir(valor, 8);
+    }
+
+    /**
+     * @brief Obtiene la posición actual en bits.
+     */
+    long getBits() const { return posBits; }
+};
+
+/**
+ * @class LectorBits
+ * @brief Lee valores de ancho arbitrario (MSB primero) desde un buffer de bytes.
+ */
+class LectorBits {
+private:
+    /// @brief Buffer de origen.
+    const unsigned char* datos;
+    /// @brief Posición actual en bits dentro del buffer.
+    long posBits;
+
+public:
+    /**
+     * @brief Constructor del lector.
+     * @param buffer Buffer de origen.
+     */
+    LectorBits(const unsigned char* buffer) : datos(buffer), posBits(0) {}
+
+    /**
+     * @brief Lee `n` bits (0..64) y los devuelve alineados a la derecha.
+     */
+    uint64_t leer(int n) {
+        uint64_t valor = 0;
+        while (n > 0) {
+            int disponibles = 8 - (int)(posBits & 7);
+            int tomar = (n < disponibles) ? n : disponibles;
+            unsigned int trozo = (datos[posBits >> 3] >> (disponibles - tomar)) & ((1u << tomar) - 1);
+            valor = (valor << tomar) | trozo;
+            posBits += tomar;
+            n -= tomar;
+        }
+        return valor;
+    }
+
+    /**
+     * @brief Lee un único bit.
+     */
+    bool leerBit() {
+        bool bit = (datos[posBits >> 3] & (0x80 >> (posBits & 7))) != 0;
+        posBits++;
+        return bit;
+    }
+
+    /**
+     * @brief Lee un entero sin signo en formato varint.
+     */
+    uint64_t leerVarint() {
+        uint64_t valor = 0;
+        int desplazamiento = 0;
+        while (true) {
+            uint64_t byte = leer(8);
+            valor |= (byte & 0x7F) << desplazamiento;
+            if ((byte & 0x80) == 0) break;
+            desplazamiento += 7;
+        }
+        return valor;
+    }
+};
+
+/**
+ * @brief Codificación zigzag: mapea enteros con signo pequeños a enteros sin signo pequeños.
+ */
+inline uint64_t zigzagCodificar(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+/**
+ * @brief Inversa de zigzagCodificar().
+ */
+inline int64_t zigzagDecodificar(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+/**
+ * @struct Codificador
+ * @brief Codificador de muestras de tipo T sobre un flujo de bits.
+ * @details Solo existen las especializaciones para float e int. Cada una
+ * define un `Estado` que el escritor y el lector actualizan en espejo;
+ * reiniciarlo al abrir un bloque hace que cada bloque se decodifique por
+ * separado.
+ * @tparam T El tipo de la muestra.
+ */
+template <typename T>
+struct Codificador;
+
+/**
+ * @brief Especialización para float: valores decimales escalados con respaldo XOR de Gorilla.
+ * @details Las lecturas de los sensores suelen tener una resolución decimal
+ * fija (p. ej. 0.1 grados), y esos valores no comparten bits de mantisa
+ * entre sí, por lo que el XOR de Gorilla apenas los comprime. Por eso la
+ * primera muestra de cada bloque se guarda completa y fija `decimales`: el
+ * menor d en 0..MAX_DECIMALES tal que valor·10^d es un entero k que
+ * reconstruye el float exacto. Las siguientes se guardan como la diferencia
+ * de k con la anterior:
+ * - `0`: mismo valor (1 bit),
+ * - `10` + 4 bits, `110` + 8 bits o `1110` + 16 bits: diferencia en zigzag,
+ * - `1111` + XOR de Gorilla: el valor no es decimal o la diferencia no cabe.
+ *
+ * Si la primera muestra no es decimal el bloque entero usa Gorilla puro:
+ * `0` si el valor se repite y, si no, `1` + XOR (solo los bits
+ * significativos, reutilizando la ventana de ceros si cabe). En ambos casos
+ * la decodificación es exacta bit a bit.
+ */
+template <>
+struct Codificador<float> {
+    /// @brief Peor caso de bits por muestra (escape: 4 + 1 + 5 + 5 + 32, redondeado).
+    static const int MAX_BITS = 48;
+    /// @brief Máximo de decimales que se prueban al abrir un bloque.
+    static const int MAX_DECIMALES = 4;
+
+    /**
+     * @struct Estado
+     * @brief Estado compartido por codificación y decodificación.
+     */
+    struct Estado {
+        /// @brief Bits del valor anterior.
+        uint32_t anterior;
+        /// @brief Ceros a la izquierda de la ventana vigente.
+        int cerosIzq;
+        /// @brief Ceros a la derecha de la ventana vigente.
+        int cerosDer;
+        /// @brief Número de muestras procesadas en el bloque.
+        int cantidad;
+        /// @brief Decimales del bloque (-1 = Gorilla puro).
+        int decimales;
+        /// @brief Último valor decimal escalado (valor·10^decimales).
+        int64_t entero;
+    };
+
+    /**
+     * @brief Reinicia el estado al abrir un bloque.
+     */
+    static void iniciar(Estado& e) {
+        e.anterior = 0;
+        e.cerosIzq = -1; // Sin ventana previa
+        e.cerosDer = 0;
+        e.cantidad = 0;
+        e.decimales = -1;
+        e.entero = 0;
+    }
+
+    /**
+     * @brief Codifica un valor y actualiza el estado.
+     */
+    static void codificar(Estado& e, EscritorBits& w, float valor) {
+        uint32_t bits;
+        memcpy(&bits, &valor, sizeof(bits));
+        if (e.cantidad++ == 0) {
+            w.escribir(bits, 32);
+            e.anterior = bits;
+            e.decimales = -1;
+            for (int d = 0; d <= MAX_DECIMALES; d++) {
+                if (aEntero(valor, d, e.entero)) {
+                    e.decimales = d;
+                    break;
+                }
+            }
+            return;
+        }
+
+        uint32_t x = bits ^ e.anterior;
+        e.anterior = bits;
+        if (x == 0) {
+            w.escribirBit(false);
+            return;
+        }
+        w.escribirBit(true);
+        if (e.decimales < 0) {
+            escribirXor(e, w, x);
+            return;
+        }
+
+        int64_t k = 0;
+        bool decimal = aEntero(valor, e.decimales, k);
+        uint64_t zz = decimal ? zigzagCodificar(k - e.entero) : 0;
+        // El '1' ya escrito es el primer bit de cada prefijo
+        if (decimal && zz < (1u << 4)) {
+            w.escribirBit(false);
+            w.escribir(zz, 4);
+        } else if (decimal && zz < (1u << 8)) {
+            w.escribir(0x2, 2);
+            w.escribir(zz, 8);
+        } else if (decimal && zz < (1u << 16)) {
+            w.escribir(0x6, 3);
+            w.escribir(zz, 16);
+        } else {
+            w.escribir(0x7, 3); // Escape '1111'
+            escribirXor(e, w, x);
+        }
+        if (decimal) e.entero = k;
+    }
+
+    /**
+     * @brief Decodifica el siguiente valor y actualiza el estado.
+     */
+    static float decodificar(Estado& e, LectorBits& r) {
+        float valor;
+        if (e.cantidad++ == 0) {
+            e.anterior = (uint32_t)r.leer(32);
+            memcpy(&valor, &e.anterior, sizeof(valor));
+            e.decimales = -1;
+            for (int d = 0; d <= MAX_DECIMALES; d++) {
+                if (aEntero(valor, d, e.entero)) {
+                    e.decimales = d;
+                    break;
+                }
+            }
+            return valor;
+        }
+
+        if (r.leerBit()) {
+            if (e.decimales < 0) {
+                e.anterior ^= leerXor(e, r);
+            } else {
+                int ancho = 4;
+                if (r.leerBit()) {
+                    ancho = 8;
+                    if (r.leerBit()) {
+                        ancho = 16;
+                        if (r.leerBit()) ancho = 0; // Escape
+                    }
+                }
+                if (ancho > 0) {
+                    e.entero += zigzagDecodificar(r.leer(ancho));
+                    valor = desdeEntero(e.entero, e.decimales);
+                    memcpy(&e.anterior, &valor, sizeof(valor));
+                    return valor;
+                }
+                e.anterior ^= leerXor(e, r);
+                memcpy(&valor, &e.anterior, sizeof(valor));
+                int64_t k;
+                if (aEntero(valor, e.decimales, k)) e.entero = k;
+                return valor;
+            }
+        }
+        memcpy(&valor, &e.anterior, sizeof(valor));
+        return valor;
+    }
+
+private:
+    /**
+     * @brief Reconstruye el float de un valor decimal escalado.
+     */
+    static float desdeEntero(int64_t k, int decimales) {
+        return (float)((double)k / potencia(decimales));
+    }
+
+    /**
+     * @brief 10^decimales.
+     */
+    static double potencia(int decimales) {
+        static const double potencias[MAX_DECIMALES + 1] = {1.0, 10.0, 100.0, 1000.0, 10000.0};
+        return potencias[decimales];
+    }
+
+    /**
+     * @brief Escala `valor` por 10^decimales si el resultado es un entero exacto.
+     * @param k Recibe el entero escalado.
+     * @return true si desdeEntero(k, decimales) reproduce `valor` bit a bit.
+     */
+    static bool aEntero(float valor, int decimales, int64_t& k) {
+        double escalado = (double)valor * potencia(decimales);
+        // También descarta NaN e infinitos
+        if (!(escalado > -9.0e15 && escalado < 9.0e15)) return false;
+        k = (int64_t)(escalado < 0 ? escalado - 0.5 : escalado + 0.5);
+        float reconstruido = desdeEntero(k, decimales);
+        return memcmp(&reconstruido, &valor, sizeof(valor)) == 0;
+    }
+
+    /**
+     * @brief Escribe un XOR distinto de cero con la ventana de ceros de Gorilla.
+     */
+    static void escribirXor(Estado& e, EscritorBits& w, uint32_t x) {
+        int izq = __builtin_clz(x);
+        int der = __builtin_ctz(x);
+        if (izq > 31) izq = 31;
+
+        if (e.cerosIzq >= 0 && izq >= e.cerosIzq && der >= e.cerosDer) {
+            // Cabe en la ventana anterior: solo los bits significativos
+            w.escribirBit(false);
+            int significativos = 32 - e.cerosIzq - e.cerosDer;
+            w.escribir(x >> e.cerosDer, significativos);
+        } else {
+            int significativos = 32 - izq - der;
+            w.escribirBit(true);
+            w.escribir((uint64_t)izq, 5);
+            w.escribir((uint64_t)(significativos - 1), 5);
+            w.escribir(x >> der, significativos);
+            e.cerosIzq = izq;
+            e.cerosDer = der;
+        }
+    }
+
+    /**
+     * @brief Lee un XOR escrito por escribirXor().
+     */
+    static uint32_t leerXor(Estado& e, LectorBits& r) {
+        if (r.leerBit()) {
+            e.cerosIzq = (int)r.leer(5);
+            int significativos = (int)r.leer(5) + 1;
+            e.cerosDer = 32 - e.cerosIzq - significativos;
+        }
+        int significativos = 32 - e.cerosIzq - e.cerosDer;
+        return (uint32_t)r.leer(significativos) << e.cerosDer;
+    }
+};
+
+/**
+ * @brief Especialización para int: delta-de-delta con zigzag + varint.
+ * @details La primera muestra se guarda completa, la segunda como delta y
+ * las siguientes como la diferencia entre deltas consecutivos. Una señal
+ * constante o de pendiente constante cuesta 1 byte por muestra.
+ */
+template <>
+struct Codificador<int> {
+    /// @brief Peor caso de bits por muestra (varint de 64 bits: 10 bytes).
+    static const int MAX_BITS = 80;
+
+    /**
+     * @struct Estado
+     * @brief Estado compartido por codificación y decodificación.
+     */
+    struct Estado {
+        /// @brief Valor anterior.
+        int64_t anterior;
+        /// @brief Delta anterior.
+        int64_t deltaAnterior;
+        /// @brief Número de muestras procesadas en el bloque.
+        int cantidad;
+    };
+
+    /**
+     * @brief Reinicia el estado al abrir un bloque.
+     */
+    static void iniciar(Estado& e) {
+        e.anterior = 0;
+        e.deltaAnterior = 0;
+        e.cantidad = 0;
+    }
+
+    /**
+     * @brief Codifica un valor y actualiza el estado.
+     */
+    static void codificar(Estado& e, EscritorBits& w, int valor) {
+        int64_t v = valor;
+        if (e.cantidad == 0) {
+            w.escribirVarint(zigzagCodificar(v));
+        } else {
+            int64_t delta = v - e.anterior;
+            w.escribirVarint(zigzagCodificar(e.cantidad == 1 ? delta : delta - e.deltaAnterior));
+            e.deltaAnterior = delta;
+        }
+        e.anterior = v;
+        e.cantidad++;
+    }
+
+    /**
+     * @brief Decodifica el siguiente valor y actualiza el estado.
+     */
+    static int decodificar(Estado& e, LectorBits& r) {
+        int64_t leido = zigzagDecodificar(r.leerVarint());
+        if (e.cantidad == 0) {
+            e.anterior = leido;
+        } else {
+            int64_t delta = (e.cantidad == 1) ? leido : e.deltaAnterior + leido;
+            e.anterior += delta;
+            e.deltaAnterior = delta;
+        }
+        e.cantidad++;
+        return (int)e.anterior;
+    }
+};
+
+/**
+ * @struct CodificadorTiempos
+ * @brief Codificador de marcas de tiempo: delta-de-delta con prefijos de Gorilla.
+ * @details A diferencia de Codificador<int>, que trabaja por bytes, aquí el
+ * delta-de-delta (en zigzag) se guarda con un prefijo de longitud variable:
+ * `0` si es cero, `10` + 7 bits, `110` + 9 bits, `1110` + 12 bits o
+ * `1111` + 64 bits. Con un muestreo regular cada marca cuesta 1 bit.
+ */
+struct CodificadorTiempos {
+    /// @brief Peor caso de bits por marca (4 + 64).
+    static const int MAX_BITS = 68;
+
+    /**
+     * @struct Estado
+     * @brief Estado compartido por codificación y decodificación.
+     */
+    struct Estado {
+        /// @brief Marca anterior.
+        uint64_t anterior;
+        /// @brief Delta anterior.
+        int64_t deltaAnterior;
+        /// @brief Número de marcas procesadas en el bloque.
+        int cantidad;
+    };
+
+    /**
+     * @brief Reinicia el estado al abrir un bloque.
+     */
+    static void iniciar(Estado& e) {
+        e.anterior = 0;
+        e.deltaAnterior = 0;
+        e.cantidad = 0;
+    }
+
+    /**
+     * @brief Codifica una marca y actualiza el estado.
+     */
+    static void codificar(Estado& e, EscritorBits& w, uint64_t marca) {
+        if (e.cantidad++ == 0) {
+            w.escribir(marca, 64);
+            e.anterior = marca;
+            return;
+        }
+        int64_t delta = (int64_t)(marca - e.anterior);
+        uint64_t zz = zigzagCodificar(delta - e.deltaAnterior);
+        if (zz == 0) {
+            w.escribirBit(false);
+        } else if (zz < (1u << 7)) {
+            w.escribir(0x2, 2);
+            w.escribir(zz, 7);
+        } else if (zz < (1u << 9)) {
+            w.escribir(0x6, 3);
+            w.escribir(zz, 9);
+        } else if (zz < (1u << 12)) {
+            w.escribir(0xE, 4);
+            w.escribir(zz, 12);
+        } else {
+            w.escribir(0xF, 4);
+            w.escribir(zz, 64);
+        }
+        e.anterior = marca;
+        e.deltaAnterior = delta;
+    }
+
+    /**
+     * @brief Decodifica la siguiente marca y actualiza el estado.
+     */
+    static uint64_t decodificar(Estado& e, LectorBits& r) {
+        if (e.cantidad++ == 0) {
+            e.anterior = r.leer(64);
+            return e.anterior;
+        }
+        uint64_t zz = 0;
+        if (r.leerBit()) {
+            if (!r.leerBit()) {
+                zz = r.leer(7);
+            } else if (!r.leerBit()) {
+                zz = r.leer(9);
+            } else if (!r.leerBit()) {
+                zz = r.leer(12);
+            } else {
+                zz = r.leer(64);
+            }
+        }
+        e.deltaAnterior += zigzagDecodificar(zz);
+        e.anterior += (uint64_t)e.deltaAnterior;
+        return e.anterior;
+    }
+};
+
+#endif
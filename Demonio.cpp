@@ -0,0 +1,393 @@
+/**
+ * @file Demonio.cpp
+ * @brief Implementación del modo demonio.
+ */
+
+#include "Demonio.h"
+#include "Exportador.h"
+#include "Tiempo.h"
+#include <cerrno>
+#include <climits> // Para INT_MAX
+#include <csignal>
+#include <cstdio>  // Para fopen, fgets, snprintf
+#include <cstdlib> // Para strtol, strtod
+#include <cstring>
+#include <poll.h>
+
+/// @brief Lo pone en 1 el manejador de SIGINT/SIGTERM.
+static volatile sig_atomic_t detenido = 0;
+
+static void alRecibirSenal(int) {
+    detenido = 1;
+}
+
+/**
+ * @brief Convierte una palabra completa a entero.
+ * @return false si no es un entero.
+ */
+static bool leerEntero(const char* texto, long& valor) {
+    char* fin;
+    errno = 0;
+    valor = strtol(texto, &fin, 10);
+    return fin != texto && *fin == '\0' && errno == 0;
+}
+
+/**
+ * @brief Convierte una palabra completa a float.
+ * @return false si no es un número.
+ */
+static bool leerFloat(const char* texto, float& valor) {
+    char* fin;
+    valor = (float)strtod(texto, &fin);
+    return fin != texto && *fin == '\0';
+}
+
+Demonio::Demonio() : numPuertos(0), intervaloProceso(1000) {
+    baseExportar[0] = '\0';
+}
+
+int Demonio::buscarPuerto(const char* ruta) const {
+    for (int i = 0; i < numPuertos; i++) {
+        if (strcmp(puertos[i].ruta, ruta) == 0) return i;
+    }
+    return -1;
+}
+
+bool Demonio::cargarConfiguracion(const char* ruta) {
+    FILE* archivo = fopen(ruta, "r");
+    if (archivo == nullptr) {
+        std::cerr << "Error [Demonio] al abrir la configuracion " << ruta << std::endl;
+        return false;
+    }
+
+    char linea[512];
+    int numLinea = 0;
+    bool ok = true;
+    while (fgets(linea, sizeof(linea), archivo) != nullptr) {
+        numLinea++;
+        char* comentario = strchr(linea, '#');
+        if (comentario != nullptr) *comentario = '\0';
+
+        // Separar en palabras
+        char* tokens[8];
+        int n = 0;
+        for (char* t = strtok(linea, " \t\r\n"); t != nullptr; t = strtok(nullptr, " \t\r\n")) {
+            if (n == 8) {
+                n++;
+                break;
+            }
+            tokens[n++] = t;
+        }
+        if (n == 0) continue; // Línea vacía o solo comentario
+        if (n > 8) {
+            std::cerr << "Error [Demonio] " << ruta << ":" << numLinea << ": demasiadas palabras" << std::endl;
+            ok = false;
+            continue;
+        }
+        if (!aplicarDirectiva(tokens, n, ruta, numLinea)) ok = false;
+    }
+    fclose(archivo);
+
+    if (ok && numPuertos == 0) {
+        std::cerr << "Error [Demonio] " << ruta << ": no hay ningun puerto configurado" << std::endl;
+        ok = false;
+    }
+    return ok;
+}
+
+bool Demonio::aplicarDirectiva(char* tokens[], int n, const char* archivo, int numLinea) {
+    const char* directiva = tokens[0];
+    long entero;
+
+    if (strcmp(directiva, "puerto") == 0) {
+        if (n != 3 || !leerEntero(tokens[2], entero) || entero <= 0) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": uso: puerto <ruta> <baudios>" << std::endl;
+            return false;
+        }
+        if (buscarPuerto(tokens[1]) != -1) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": puerto repetido " << tokens[1] << std::endl;
+            return false;
+        }
+        if (numPuertos == MAX_PUERTOS || strlen(tokens[1]) >= sizeof(puertos[0].ruta)) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": demasiados puertos o ruta muy larga" << std::endl;
+            return false;
+        }
+        Puerto& p = puertos[numPuertos++];
+        strcpy(p.ruta, tokens[1]);
+        p.baudios = (int)entero;
+        p.numRutas = 0;
+        for (int t = 0; t < NUM_TIPOS_SENSOR; t++) p.porTipo[t] = -1;
+        p.lineas = 0;
+        p.descartadas = 0;
+        return true;
+    }
+
+    if (strcmp(directiva, "sensor") == 0) {
+        if (n < 4 || n > 6 || strlen(tokens[1]) != 1 || (tokens[1][0] != 'T' && tokens[1][0] != 'P')) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea
+                      << ": uso: sensor <T|P> <nombre> <puerto> [lista|comprimido|concurrente] [retencion]" << std::endl;
+            return false;
+        }
+        const char* nombre = tokens[2];
+        int indicePuerto = buscarPuerto(tokens[3]);
+        if (indicePuerto == -1) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": puerto no declarado " << tokens[3] << std::endl;
+            return false;
+        }
+        Puerto& p = puertos[indicePuerto];
+        if (p.numRutas == MAX_SENSORES_POR_PUERTO || strlen(nombre) >= sizeof(p.rutas[0].nombre)) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": demasiados sensores o nombre muy largo" << std::endl;
+            return false;
+        }
+        if (sistema.buscarSensor(nombre) != nullptr) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": sensor repetido " << nombre << std::endl;
+            return false;
+        }
+
+        ModoHistorial modo = HISTORIAL_LISTA;
+        if (n >= 5) {
+            if (strcmp(tokens[4], "lista") == 0) modo = HISTORIAL_LISTA;
+            else if (strcmp(tokens[4], "comprimido") == 0) modo = HISTORIAL_COMPRIMIDO;
+            else if (strcmp(tokens[4], "concurrente") == 0) modo = HISTORIAL_CONCURRENTE;
+            else {
+                std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": modo desconocido " << tokens[4] << std::endl;
+                return false;
+            }
+        }
+        entero = -1;
+        if (n == 6 && (!leerEntero(tokens[5], entero) || entero < 0 || entero > INT_MAX)) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": retencion invalida " << tokens[5] << std::endl;
+            return false;
+        }
+
+        TipoSensor tipo = (tokens[1][0] == 'T') ? SENSOR_TEMPERATURA : SENSOR_PRESION;
+        ManejadorSensor h;
+        if (tipo == SENSOR_TEMPERATURA) {
+            h = sistema.agregarSensor<SensorTemperatura>(nombre, modo);
+        } else {
+            h = sistema.agregarSensor<SensorPresion>(nombre, modo);
+        }
+        if (entero >= 0) sistema.configurarRetencion(h, (int)entero);
+
+        if (p.porTipo[tipo] == -1) p.porTipo[tipo] = p.numRutas;
+        Ruta& r = p.rutas[p.numRutas++];
+        strcpy(r.nombre, nombre);
+        r.largo = (int)strlen(nombre);
+        r.sensor = h;
+        return true;
+    }
+
+    if (strcmp(directiva, "alerta") == 0) {
+        ReglaAlerta regla;
+        if (n != 6 || !leerFloat(tokens[2], regla.minimo) || !leerFloat(tokens[3], regla.maximo) ||
+            !leerFloat(tokens[4], regla.maxCambioPorSegundo) || !leerFloat(tokens[5], regla.histeresis)) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea
+                      << ": uso: alerta <T|P|nombre> <minimo> <maximo> <cambio_por_segundo> <histeresis>" << std::endl;
+            return false;
+        }
+        if (strcmp(tokens[1], "T") == 0) {
+            sistema.definirAlertaTipo(SENSOR_TEMPERATURA, regla);
+        } else if (strcmp(tokens[1], "P") == 0) {
+            sistema.definirAlertaTipo(SENSOR_PRESION, regla);
+        } else if (!sistema.definirAlertaSensor(sistema.buscarManejador(tokens[1]), regla)) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": sensor no declarado " << tokens[1] << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    if (strcmp(directiva, "intervalo_proceso") == 0) {
+        if (n != 2 || !leerEntero(tokens[1], entero) || entero < 0 || entero > 86400000) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": uso: intervalo_proceso <ms>" << std::endl;
+            return false;
+        }
+        intervaloProceso = (int)entero;
+        return true;
+    }
+
+    if (strcmp(directiva, "exportar") == 0) {
+        if (n != 2 || strlen(tokens[1]) >= sizeof(baseExportar)) {
+            std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": uso: exportar <nombre_base>" << std::endl;
+            return false;
+        }
+        strcpy(baseExportar, tokens[1]);
+        return true;
+    }
+
+    std::cerr << "Error [Demonio] " << archivo << ":" << numLinea << ": directiva desconocida " << directiva << std::endl;
+    return false;
+}
+
+bool Demonio::iniciar() {
+    for (int i = 0; i < numPuertos; i++) {
+        Puerto& p = puertos[i];
+        if (!p.serial.abrir(p.ruta, p.baudios)) {
+            std::cerr << "Error [Demonio] no se pudo abrir " << p.ruta << " a " << p.baudios << " baudios" << std::endl;
+            return false;
+        }
+        std::cout << "[Demonio] Puerto " << p.ruta << " abierto a " << p.baudios << " baudios ("
+                  << p.numRutas << " sensores)." << std::endl;
+    }
+    sistema.getAlertas().configurarCallback(Sistema::imprimirAlerta, &sistema);
+    return true;
+}
+
+void Demonio::despachar(Puerto& p, const char* linea, int largo) {
+    const char* dosPuntos = static_cast<const char*>(memchr(linea, ':', largo));
+    if (dosPuntos == nullptr) {
+        p.descartadas++;
+        return;
+    }
+
+    // "T:" y "P:" van al sensor por defecto de su tipo; el resto, por nombre
+    int prefijo = (int)(dosPuntos - linea);
+    int destino = -1;
+    if (prefijo == 1 && linea[0] == 'T') {
+        destino = p.porTipo[SENSOR_TEMPERATURA];
+    } else if (prefijo == 1 && linea[0] == 'P') {
+        destino = p.porTipo[SENSOR_PRESION];
+    } else {
+        for (int i = 0; i < p.numRutas; i++) {
+            if (p.rutas[i].largo == prefijo && memcmp(p.rutas[i].nombre, linea, prefijo) == 0) {
+                destino = i;
+                break;
+            }
+        }
+    }
+    if (destino == -1) {
+        p.descartadas++;
+        return;
+    }
+    // Un valor que no es un número (ruido en la línea) no entra como lectura 0
+    if (!sistema.registrarDesdeTexto(p.rutas[destino].sensor, dosPuntos + 1)) {
+        p.descartadas++;
+        return;
+    }
+    p.lineas++;
+}
+
+int Demonio::ejecutar() {
+    // Sin SA_RESTART: la señal interrumpe poll() con EINTR
+    struct sigaction accion;
+    memset(&accion, 0, sizeof(accion));
+    accion.sa_handler = alRecibirSenal;
+    sigemptyset(&accion.sa_mask);
+    sigaction(SIGINT, &accion, nullptr);
+    sigaction(SIGTERM, &accion, nullptr);
+
+    struct pollfd fds[MAX_PUERTOS];
+    for (int i = 0; i < numPuertos; i++) {
+        fds[i].fd = puertos[i].serial.getFd();
+        fds[i].events = POLLIN;
+        fds[i].revents = 0;
+    }
+    int abiertos = numPuertos;
+    char linea[TAM_LINEA];
+
+    MarcaTiempo inicio = tiempoActual();
+    MarcaTiempo proximoProceso = inicio + (MarcaTiempo)intervaloProceso;
+    std::cout << "[Demonio] En marcha (procesamiento ";
+    if (intervaloProceso > 0) {
+        std::cout << "cada " << intervaloProceso << " ms";
+    } else {
+        std::cout << "solo al terminar";
+    }
+    std::cout << "). Ctrl+C para terminar." << std::endl;
+
+    while (!detenido && abiertos > 0) {
+        int espera = -1;
+        if (intervaloProceso > 0) {
+            MarcaTiempo ahora = tiempoActual();
+            espera = (proximoProceso > ahora) ? (int)(proximoProceso - ahora) : 0;
+        }
+
+        int listos = poll(fds, numPuertos, espera);
+        if (listos < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error [Demonio] poll fallo" << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < numPuertos && listos > 0; i++) {
+            if (fds[i].revents == 0) continue;
+            listos--;
+            Puerto& p = puertos[i];
+
+            // Se lee todo lo disponible de una vez y se ingresan todas las líneas completas
+            if (fds[i].revents & POLLIN) {
+                int leidos = p.serial.rellenar();
+                if (leidos > 0) {
+                    int largo;
+                    while ((largo = p.serial.extraerLinea(linea, TAM_LINEA)) > 0) {
+                        despachar(p, linea, largo);
+                    }
+                    continue;
+                }
+                if (leidos < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+            } else if (!(fds[i].revents & (POLLHUP | POLLERR | POLLNVAL))) {
+                continue;
+            }
+
+            // Fin de archivo o error: el dispositivo se desconectó
+            std::cerr << "Error [Demonio] se cerro el puerto " << p.ruta << std::endl;
+            p.serial.cerrar();
+            fds[i].fd = -1; // poll() ignora los fd negativos
+            abiertos--;
+        }
+
+        // El callback ya las imprimió: se vacía la cola para que no se llene
+        Alerta alerta;
+        while (sistema.getAlertas().siguienteAlerta(alerta)) {}
+
+        if (intervaloProceso > 0) {
+            MarcaTiempo ahora = tiempoActual();
+            if (ahora >= proximoProceso) {
+                sistema.procesarTodos();
+                proximoProceso += (MarcaTiempo)intervaloProceso;
+                // Si el procesamiento se atrasó, no se encadenan los pendientes
+                if (proximoProceso <= ahora) proximoProceso = ahora + (MarcaTiempo)intervaloProceso;
+            }
+        }
+    }
+
+    MarcaTiempo duracion = tiempoActual() - inicio;
+    std::cout << "\n[Demonio] Deteniendo..." << std::endl;
+    sistema.procesarTodos();
+    if (baseExportar[0] != '\0') exportarFinal();
+    imprimirResumen(duracion);
+    return 0;
+}
+
+void Demonio::exportarFinal() {
+    char ruta[210];
+
+    ExportadorColumnar columnar;
+    snprintf(ruta, sizeof(ruta), "%s.monc", baseExportar);
+    if (columnar.abrir(ruta) && sistema.exportar(columnar)) {
+        std::cout << "[Demonio] Exportadas " << columnar.getTotalLecturas() << " lecturas a " << ruta << "." << std::endl;
+    }
+
+    ExportadorCSV csv;
+    snprintf(ruta, sizeof(ruta), "%s.csv", baseExportar);
+    if (csv.abrir(ruta) && sistema.exportar(csv)) {
+        std::cout << "[Demonio] Exportadas " << csv.getTotalLecturas() << " lecturas a " << ruta << "." << std::endl;
+    }
+}
+
+void Demonio::imprimirResumen(uint64_t duracionMs) const {
+    uint64_t total = 0;
+    std::cout << "[Demonio] Resumen (" << duracionMs << " ms):" << std::endl;
+    for (int i = 0; i < numPuertos; i++) {
+        const Puerto& p = puertos[i];
+        std::cout << "  " << p.ruta << ": " << p.lineas << " lecturas, "
+                  << p.descartadas << " lineas descartadas." << std::endl;
+        total += p.lineas;
+    }
+    if (duracionMs > 0) {
+        std::cout << "  Total: " << total << " lecturas (" << (total * 1000 / duracionMs) << " por segundo)." << std::endl;
+    }
+    uint32_t perdidas = sistema.getAlertas().getAlertasPerdidas();
+    if (perdidas > 0) {
+        std::cout << "  Alertas descartadas por cola llena: " << perdidas << std::endl;
+    }
+}
@@ -0,0 +1,152 @@
+/**
+ * @file Demonio.h
+ * @brief Define el modo demonio: ingreso y procesamiento continuo sin menú.
+ */
+#ifndef DEMONIO_H
+#define DEMONIO_H
+
+#include "Sistema.h"
+#include "Serial.h"
+#include <stdint.h>
+
+/**
+ * @class Demonio
+ * @brief Ejecuta el Sistema sin intervención, configurado desde un archivo.
+ * @details El archivo de configuración tiene una directiva por línea ('#'
+ * inicia un comentario):
+ * - `puerto <ruta> <baudios>`
+ * - `sensor <T|P> <nombre> <ruta_puerto> [lista|comprimido|concurrente] [retencion]`
+ * - `alerta <T|P|nombre> <minimo> <maximo> <cambio_por_segundo> <histeresis>`
+ * - `intervalo_proceso <ms>` (0 = solo al terminar; por defecto 1000)
+ * - `exportar <nombre_base>` (exporta .monc y .csv al terminar)
+ *
+ * Los puertos se vigilan todos juntos con poll(): cada vez que uno tiene
+ * datos se lee de una vez todo lo disponible y se ingresan todas las líneas
+ * completas. Una línea "T:valor" o "P:valor" va al primer sensor de ese
+ * tipo declarado en el puerto, y "nombre:valor" al sensor con ese nombre.
+ * Entre lecturas se llama a procesarTodos() cada `intervalo_proceso` ms.
+ * Termina con SIGINT o SIGTERM, o cuando se cierran todos los puertos.
+ */
+class Demonio {
+public:
+    /// @brief Puertos máximos.
+    static const int MAX_PUERTOS = 16;
+    /// @brief Sensores máximos por puerto.
+    static const int MAX_SENSORES_POR_PUERTO = 32;
+    /// @brief Largo máximo de una línea recibida.
+    static const int TAM_LINEA = 100;
+
+private:
+    /**
+     * @struct Ruta
+     * @brief Sensor al que se dirigen las líneas "nombre:valor" de un puerto.
+     */
+    struct Ruta {
+        /// @brief Nombre del sensor (prefijo de la línea).
+        char nombre[50];
+        /// @brief Largo de `nombre`.
+        int largo;
+        /// @brief Manejador del sensor.
+        ManejadorSensor sensor;
+    };
+
+    /**
+     * @struct Puerto
+     * @brief Puerto serial vigilado y sus sensores.
+     */
+    struct Puerto {
+        /// @brief Ruta del dispositivo.
+        char ruta[100];
+        /// @brief Velocidad configurada.
+        int baudios;
+        /// @brief El puerto abierto.
+        Serial serial;
+        /// @brief Sensores del puerto, en orden de declaración.
+        Ruta rutas[MAX_SENSORES_POR_PUERTO];
+        /// @brief Sensores en `rutas`.
+        int numRutas;
+        /// @brief Destino de "T:" y "P:" (índice en `rutas`, -1 si no hay).
+        int porTipo[NUM_TIPOS_SENSOR];
+        /// @brief Líneas ingresadas.
+        uint64_t lineas;
+        /// @brief Líneas que no correspondían a ningún sensor o cuyo valor no era un número.
+        uint64_t descartadas;
+    };
+
+    /// @brief El sistema que recibe las lecturas.
+    Sistema sistema;
+    /// @brief Puertos configurados.
+    Puerto puertos[MAX_PUERTOS];
+    /// @brief Puertos en `puertos`.
+    int numPuertos;
+    /// @brief Milisegundos entre procesamientos (0 = solo al terminar).
+    int intervaloProceso;
+    /// @brief Nombre base de la exportación final ("" = no exportar).
+    char baseExportar[200];
+
+    /**
+     * @brief Interpreta una línea del archivo de configuración.
+     * @param tokens Palabras de la línea.
+     * @param n Número de palabras (al menos 1).
+     * @param archivo Nombre del archivo (para los mensajes de error).
+     * @param numLinea Número de la línea (para los mensajes de error).
+     * @return false si la directiva es inválida (el error ya se informó).
+     */
+    bool aplicarDirectiva(char* tokens[], int n, const char* archivo, int numLinea);
+
+    /**
+     * @brief Busca un puerto configurado por su ruta.
+     * @return Su índice, o -1 si no existe.
+     */
+    int buscarPuerto(const char* ruta) const;
+
+    /**
+     * @brief Ingresa una línea recibida en el sensor que le corresponde.
+     * @details Las líneas sin sensor o con un valor que no es un número se
+     * cuentan en `descartadas` y no se ingresan.
+     */
+    void despachar(Puerto& p, const char* linea, int largo);
+
+    /**
+     * @brief Exporta los historiales a `baseExportar`.monc y .csv.
+     */
+    void exportarFinal();
+
+    /**
+     * @brief Imprime las líneas ingresadas y descartadas por puerto.
+     * @param duracionMs Tiempo que estuvo en marcha.
+     */
+    void imprimirResumen(uint64_t duracionMs) const;
+
+public:
+    /**
+     * @brief Constructor. Sin puertos ni sensores.
+     */
+    Demonio();
+
+    /**
+     * @brief Lee el archivo de configuración y crea los sensores.
+     * @param ruta Ruta del archivo.
+     * @return false si el archivo no existe o tiene errores.
+     */
+    bool cargarConfiguracion(const char* ruta);
+
+    /**
+     * @brief Abre todos los puertos configurados.
+     * @return false si alguno no se pudo abrir.
+     */
+    bool iniciar();
+
+    /**
+     * @brief Ingresa y procesa lecturas hasta recibir SIGINT/SIGTERM.
+     * @return Código de salida del programa.
+     */
+    int ejecutar();
+
+private:
+    // No copiable.
+    Demonio(const Demonio&);
+    Demonio& operator=(const Demonio&);
+};
+
+#endif
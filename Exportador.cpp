@@ -0,0 +1,336 @@
+/**
+ * @file Exportador.cpp
+ * @brief Implementación del archivo con buffer y de los exportadores.
+ */
+
+#include "Exportador.h"
+#include <cerrno>
+#include <cstdio>  // Para snprintf
+#include <fcntl.h>
+#include <unistd.h>
+
+// --- Implementación ArchivoBuffer ---
+ArchivoBuffer::ArchivoBuffer() : fd(-1), buffer(nullptr), usados(0), escritos(0), fallo(false) {}
+
+ArchivoBuffer::~ArchivoBuffer() {
+    if (fd != -1) cerrar();
+    delete[] buffer;
+}
+
+bool ArchivoBuffer::abrir(const char* ruta) {
+    fd = open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Error [Exportador] al abrir " << ruta << std::endl;
+        return false;
+    }
+    if (buffer == nullptr) buffer = new char[TAM_BUFFER];
+    usados = 0;
+    escritos = 0;
+    fallo = false;
+    return true;
+}
+
+bool ArchivoBuffer::cerrar() {
+    vaciar();
+    close(fd);
+    fd = -1;
+    return !fallo;
+}
+
+void ArchivoBuffer::escribirDirecto(const char* datos, size_t n) {
+    while (n > 0 && !fallo) {
+        ssize_t r = write(fd, datos, n);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error [Exportador] al escribir" << std::endl;
+            fallo = true;
+            return;
+        }
+        datos += r;
+        n -= (size_t)r;
+        escritos += (uint64_t)r;
+    }
+}
+
+void ArchivoBuffer::vaciar() {
+    if (usados == 0) return;
+    escribirDirecto(buffer, (size_t)usados);
+    usados = 0;
+}
+
+
+// --- Implementación Exportador ---
+Exportador::Exportador() : enLote(0), nombreActual(""), tipoActual(SENSOR_TEMPERATURA), totalLecturas(0) {}
+
+Exportador::~Exportador() {}
+
+bool Exportador::abrir(const char* ruta) {
+    totalLecturas = 0;
+    return archivo.abrir(ruta);
+}
+
+bool Exportador::terminar() {
+    escribirPie();
+    return archivo.cerrar();
+}
+
+void Exportador::comenzarSensor(const char* nombre, TipoSensor tipo) {
+    nombreActual = nombre;
+    tipoActual = tipo;
+    enLote = 0;
+    abrirSensor();
+}
+
+void Exportador::finalizarSensor() {
+    if (enLote > 0) {
+        vaciarLote();
+        totalLecturas += enLote;
+        enLote = 0;
+    }
+    cerrarSensor();
+}
+
+
+// --- Implementación ExportadorColumnar ---
+ExportadorColumnar::ExportadorColumnar() : metas(nullptr), numMetas(0), capacidadMetas(0) {}
+
+ExportadorColumnar::~ExportadorColumnar() {
+    delete[] metas;
+}
+
+bool ExportadorColumnar::abrir(const char* ruta) {
+    numMetas = 0;
+    if (!Exportador::abrir(ruta)) return false;
+    archivo.escribir("MONC", 4);
+    uint32_t version = VERSION;
+    archivo.escribir(&version, sizeof(version));
+    return true;
+}
+
+void ExportadorColumnar::abrirSensor() {
+    if (numMetas == capacidadMetas) {
+        int nuevaCapacidad = (capacidadMetas == 0) ? 16 : capacidadMetas * 2;
+        MetaColumna* nuevas = new MetaColumna[nuevaCapacidad];
+        for (int i = 0; i < numMetas; i++) nuevas[i] = metas[i];
+        delete[] metas;
+        metas = nuevas;
+        capacidadMetas = nuevaCapacidad;
+    }
+    MetaColumna& m = metas[numMetas++];
+    strncpy(m.nombre, nombreActual, 49);
+    m.nombre[49] = '\0';
+    m.tipo = (uint8_t)tipoActual;
+    m.offset = archivo.getPosicion();
+    m.lecturas = 0;
+    m.paginas = 0;
+    m.tMin = 0;
+    m.tMax = 0;
+    m.minimo = 0;
+    m.maximo = 0;
+    m.suma = 0;
+}
+
+/**
+ * @brief Mínimo, máximo y suma de una columna de valores de 4 bytes.
+ */
+template <typename T>
+static void estadisticasColumna(const uint32_t* bits, int n, double& minimo, double& maximo, double& suma) {
+    T v;
+    memcpy(&v, &bits[0], sizeof(T));
+    T mn = v;
+    T mx = v;
+    double s = 0;
+    for (int i = 0; i < n; i++) {
+        memcpy(&v, &bits[i], sizeof(T));
+        if (v < mn) mn = v;
+        if (v > mx) mx = v;
+        s += v;
+    }
+    minimo = mn;
+    maximo = mx;
+    suma = s;
+}
+
+void ExportadorColumnar::vaciarLote() {
+    MetaColumna& m = metas[numMetas - 1];
+
+    struct {
+        uint32_t n;
+        uint32_t reservado;
+        MarcaTiempo tMin;
+        MarcaTiempo tMax;
+        double minimo;
+        double maximo;
+    } pagina;
+    double suma;
+    pagina.n = (uint32_t)enLote;
+    pagina.reservado = 0;
+    // Los tiempos llegan en orden: los extremos son la primera y la última
+    pagina.tMin = loteTiempos[0];
+    pagina.tMax = loteTiempos[enLote - 1];
+    if (tipoActual == SENSOR_TEMPERATURA) {
+        estadisticasColumna<float>(loteValores, enLote, pagina.minimo, pagina.maximo, suma);
+    } else {
+        estadisticasColumna<int>(loteValores, enLote, pagina.minimo, pagina.maximo, suma);
+    }
+
+    archivo.escribir(&pagina, sizeof(pagina));
+    archivo.escribir(loteTiempos, (size_t)enLote * sizeof(MarcaTiempo));
+    archivo.escribir(loteValores, (size_t)enLote * sizeof(uint32_t));
+
+    if (m.paginas == 0) {
+        m.tMin = pagina.tMin;
+        m.minimo = pagina.minimo;
+        m.maximo = pagina.maximo;
+    } else {
+        if (pagina.minimo < m.minimo) m.minimo = pagina.minimo;
+        if (pagina.maximo > m.maximo) m.maximo = pagina.maximo;
+    }
+    m.tMax = pagina.tMax;
+    m.suma += suma;
+    m.lecturas += (uint64_t)enLote;
+    m.paginas++;
+}
+
+void ExportadorColumnar::cerrarSensor() {}
+
+void ExportadorColumnar::escribirPie() {
+    uint64_t offsetPie = archivo.getPosicion();
+    uint32_t n = (uint32_t)numMetas;
+    archivo.escribir(&n, sizeof(n));
+    for (int i = 0; i < numMetas; i++) {
+        const MetaColumna& m = metas[i];
+        uint16_t largo = (uint16_t)strlen(m.nombre);
+        archivo.escribir(&largo, sizeof(largo));
+        archivo.escribir(m.nombre, largo);
+        archivo.escribir(&m.tipo, sizeof(m.tipo));
+        archivo.escribir(&m.offset, sizeof(m.offset));
+        archivo.escribir(&m.lecturas, sizeof(m.lecturas));
+        archivo.escribir(&m.paginas, sizeof(m.paginas));
+        archivo.escribir(&m.tMin, sizeof(m.tMin));
+        archivo.escribir(&m.tMax, sizeof(m.tMax));
+        archivo.escribir(&m.minimo, sizeof(m.minimo));
+        archivo.escribir(&m.maximo, sizeof(m.maximo));
+        archivo.escribir(&m.suma, sizeof(m.suma));
+    }
+    archivo.escribir(&offsetPie, sizeof(offsetPie));
+    archivo.escribir("MONC", 4);
+}
+
+
+// --- Implementación ExportadorCSV ---
+bool ExportadorCSV::abrir(const char* ruta) {
+    if (!Exportador::abrir(ruta)) return false;
+    const char* encabezado = "sensor,tipo,tiempo_ms,valor\n";
+    archivo.escribir(encabezado, strlen(encabezado));
+    return true;
+}
+
+/**
+ * @brief Escribe un entero sin signo en decimal.
+ * @return Número de caracteres escritos.
+ */
+static int escribirEntero(char* destino, uint64_t v) {
+    char tmp[20];
+    int n = 0;
+    do {
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    for (int i = 0; i < n; i++) destino[i] = tmp[n - 1 - i];
+    return n;
+}
+
+/**
+ * @brief Escribe un float con la menor cantidad de decimales (hasta 6) que lo reproduce.
+ * @details Las lecturas de sensores suelen tener pocos decimales, así que se
+ * prueba con 0, 1, 2... decimales usando aritmética entera, sin pasar por
+ * snprintf. Si ninguno alcanza (o el valor es enorme, NaN o infinito) se
+ * usa "%.9g", que siempre reproduce el float.
+ * @return Número de caracteres escritos.
+ */
+static int escribirFloat(char* destino, float v) {
+    static const double potencias[7] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+    float absoluto = (v < 0) ? -v : v;
+    if (absoluto < 1e9f) {
+        for (int decimales = 0; decimales <= 6; decimales++) {
+            uint64_t escalado = (uint64_t)((double)absoluto * potencias[decimales] + 0.5);
+            if ((float)((double)escalado / potencias[decimales]) != absoluto) continue;
+
+            int n = 0;
+            if (v < 0 && escalado != 0) destino[n++] = '-';
+            uint64_t divisor = (uint64_t)potencias[decimales];
+            n += escribirEntero(destino + n, escalado / divisor);
+            if (decimales > 0) {
+                destino[n++] = '.';
+                uint64_t fraccion = escalado % divisor;
+                for (int i = decimales - 1; i >= 0; i--) {
+                    destino[n + i] = (char)('0' + fraccion % 10);
+                    fraccion /= 10;
+                }
+                n += decimales;
+            }
+            return n;
+        }
+    }
+    return snprintf(destino, 32, "%.9g", v);
+}
+
+/**
+ * @brief Escribe un campo de texto CSV, entre comillas si hace falta (RFC 4180).
+ * @details Si el texto contiene una coma, comillas o un salto de línea va
+ * entre comillas y cada comilla se duplica; si no, se copia tal cual.
+ * `destino` debe tener lugar para 2·largo + 2 caracteres.
+ * @return Número de caracteres escritos.
+ */
+static int escribirCampoCSV(char* destino, const char* texto) {
+    if (strpbrk(texto, ",\"\r\n") == nullptr) {
+        int n = (int)strlen(texto);
+        memcpy(destino, texto, n);
+        return n;
+    }
+    int n = 0;
+    destino[n++] = '"';
+    for (const char* c = texto; *c != '\0'; c++) {
+        if (*c == '"') destino[n++] = '"';
+        destino[n++] = *c;
+    }
+    destino[n++] = '"';
+    return n;
+}
+
+void ExportadorCSV::vaciarLote() {
+    // Prefijo "nombre,tipo," común a todas las filas del sensor (nombres
+    // de hasta 49 caracteres: entre comillas y duplicadas ocupan < 128)
+    char prefijo[128];
+    int largoPrefijo = escribirCampoCSV(prefijo, nombreActual);
+    prefijo[largoPrefijo++] = ',';
+    prefijo[largoPrefijo++] = (tipoActual == SENSOR_TEMPERATURA) ? 'T' : 'P';
+    prefijo[largoPrefijo++] = ',';
+    // Una fila ocupa a lo sumo prefijo + 20 (tiempo) + 32 (valor) + 3
+    const int maxFila = largoPrefijo + 64;
+
+    for (int i = 0; i < enLote; i++) {
+        char* p = archivo.reservar(maxFila);
+        int n = largoPrefijo;
+        memcpy(p, prefijo, largoPrefijo);
+        n += escribirEntero(p + n, loteTiempos[i]);
+        p[n++] = ',';
+        if (tipoActual == SENSOR_TEMPERATURA) {
+            float v;
+            memcpy(&v, &loteValores[i], sizeof(v));
+            n += escribirFloat(p + n, v);
+        } else {
+            int v;
+            memcpy(&v, &loteValores[i], sizeof(v));
+            if (v < 0) {
+                p[n++] = '-';
+                n += escribirEntero(p + n, (uint64_t)(-(int64_t)v));
+            } else {
+                n += escribirEntero(p + n, (uint64_t)v);
+            }
+        }
+        p[n++] = '\n';
+        archivo.confirmar(n);
+    }
+}
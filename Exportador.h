@@ -0,0 +1,335 @@
+/**
+ * @file Exportador.h
+ * @brief Define la exportación en streaming de los historiales (binario columnar y CSV).
+ */
+#ifndef EXPORTADOR_H
+#define EXPORTADOR_H
+
+#include "Sensor.h"
+#include <stdint.h>
+#include <cstring> // Para memcpy
+
+/**
+ * @class ArchivoBuffer
+ * @brief Archivo de solo escritura con un buffer grande propio.
+ * @details Acumula en un buffer de TAM_BUFFER bytes y lo vuelca con una
+ * sola llamada write(); los bloques más grandes que el buffer se escriben
+ * directo, sin copiarse.
+ */
+class ArchivoBuffer {
+public:
+    /// @brief Tamaño del buffer de escritura (1 MiB).
+    static const int TAM_BUFFER = 1 << 20;
+
+private:
+    /// @brief File descriptor del archivo (-1 si está cerrado).
+    int fd;
+    /// @brief Buffer de escritura.
+    char* buffer;
+    /// @brief Bytes ocupados del buffer.
+    int usados;
+    /// @brief Bytes ya escritos en el archivo.
+    uint64_t escritos;
+    /// @brief true si alguna escritura falló.
+    bool fallo;
+
+    /**
+     * @brief Escribe `n` bytes en el archivo, reintentando las escrituras parciales.
+     */
+    void escribirDirecto(const char* datos, size_t n);
+
+public:
+    /**
+     * @brief Constructor. Archivo cerrado.
+     */
+    ArchivoBuffer();
+
+    /**
+     * @brief Destructor. Vuelca el buffer y cierra el archivo.
+     */
+    ~ArchivoBuffer();
+
+    /**
+     * @brief Crea (o trunca) el archivo.
+     * @return false si no se pudo abrir.
+     */
+    bool abrir(const char* ruta);
+
+    /**
+     * @brief Vuelca el buffer y cierra el archivo.
+     * @return false si alguna escritura falló.
+     */
+    bool cerrar();
+
+    /**
+     * @brief Agrega `n` bytes al archivo.
+     */
+    void escribir(const void* datos, size_t n) {
+        if (n >= (size_t)(TAM_BUFFER - usados)) {
+            vaciar();
+            if (n >= (size_t)TAM_BUFFER) {
+                escribirDirecto(static_cast<const char*>(datos), n);
+                return;
+            }
+        }
+        memcpy(buffer + usados, datos, n);
+        usados += (int)n;
+    }
+
+    /**
+     * @brief Reserva espacio contiguo en el buffer para escribir en él directamente.
+     * @param n Bytes máximos que se escribirán (menor que TAM_BUFFER).
+     * @return Puntero al espacio; confirmar con confirmar().
+     */
+    char* reservar(int n) {
+        if (n > TAM_BUFFER - usados) vaciar();
+        return buffer + usados;
+    }
+
+    /**
+     * @brief Confirma los `n` bytes escritos en el espacio de reservar().
+     */
+    void confirmar(int n) { usados += n; }
+
+    /**
+     * @brief Escribe el contenido del buffer en el archivo.
+     */
+    void vaciar();
+
+    /**
+     * @brief Obtiene la posición actual (bytes del archivo, incluido el buffer).
+     */
+    uint64_t getPosicion() const { return escritos + (uint64_t)usados; }
+
+    /**
+     * @brief Indica si alguna escritura falló.
+     */
+    bool huboError() const { return fallo; }
+
+private:
+    // No copiable.
+    ArchivoBuffer(const ArchivoBuffer&);
+    ArchivoBuffer& operator=(const ArchivoBuffer&);
+};
+
+/**
+ * @class Exportador
+ * @brief Base de los exportadores: recibe las lecturas de cada sensor por lotes.
+ * @details HistorialSensor::recorrer() entrega las lecturas una a una con
+ * lectura(); el exportador las junta en un lote de TAM_LOTE (tiempos y
+ * valores en columnas separadas, sin copiar el historial) y cada lote
+ * lleno se vuelca con vaciarLote(), que implementa cada formato. Los
+ * valores se guardan como palabras de 4 bytes: float o int según el tipo
+ * del sensor actual.
+ */
+class Exportador {
+public:
+    /// @brief Lecturas por lote (página).
+    static const int TAM_LOTE = 8192;
+
+protected:
+    /// @brief Archivo de salida.
+    ArchivoBuffer archivo;
+    /// @brief Columna de tiempos del lote.
+    MarcaTiempo loteTiempos[TAM_LOTE];
+    /// @brief Columna de valores del lote (bits de float o int).
+    uint32_t loteValores[TAM_LOTE];
+    /// @brief Lecturas en el lote.
+    int enLote;
+    /// @brief Nombre del sensor que se está exportando.
+    const char* nombreActual;
+    /// @brief Tipo del sensor que se está exportando.
+    TipoSensor tipoActual;
+    /// @brief Lecturas exportadas en total.
+    uint64_t totalLecturas;
+
+    /**
+     * @brief Escribe el lote actual (enLote > 0) en el formato del exportador.
+     */
+    virtual void vaciarLote() = 0;
+
+    /**
+     * @brief Se llama al empezar un sensor (antes de su primera lectura).
+     */
+    virtual void abrirSensor() = 0;
+
+    /**
+     * @brief Se llama al terminar un sensor (después de vaciar su último lote).
+     */
+    virtual void cerrarSensor() = 0;
+
+    /**
+     * @brief Se llama antes de cerrar el archivo (ej. para escribir el pie).
+     */
+    virtual void escribirPie() {}
+
+public:
+    /**
+     * @brief Constructor.
+     */
+    Exportador();
+
+    /**
+     * @brief Destructor virtual.
+     */
+    virtual ~Exportador();
+
+    /**
+     * @brief Crea el archivo de salida.
+     * @return false si no se pudo abrir.
+     */
+    virtual bool abrir(const char* ruta);
+
+    /**
+     * @brief Termina la exportación y cierra el archivo.
+     * @return false si alguna escritura falló.
+     */
+    bool terminar();
+
+    /**
+     * @brief Empieza a exportar un sensor.
+     */
+    void comenzarSensor(const char* nombre, TipoSensor tipo);
+
+    /**
+     * @brief Termina de exportar el sensor actual.
+     */
+    void finalizarSensor();
+
+    /**
+     * @brief Agrega una lectura float al lote (visitante de HistorialSensor::recorrer).
+     */
+    void lectura(MarcaTiempo tiempo, float valor) {
+        memcpy(&loteValores[enLote], &valor, sizeof(uint32_t));
+        agregarTiempo(tiempo);
+    }
+
+    /**
+     * @brief Agrega una lectura int al lote (visitante de HistorialSensor::recorrer).
+     */
+    void lectura(MarcaTiempo tiempo, int valor) {
+        memcpy(&loteValores[enLote], &valor, sizeof(uint32_t));
+        agregarTiempo(tiempo);
+    }
+
+    /**
+     * @brief Obtiene las lecturas exportadas hasta ahora.
+     */
+    uint64_t getTotalLecturas() const { return totalLecturas; }
+
+    /**
+     * @brief Obtiene los bytes escritos hasta ahora.
+     */
+    uint64_t getBytesEscritos() const { return archivo.getPosicion(); }
+
+private:
+    /**
+     * @brief Completa la lectura en el lote y lo vuelca si se llenó.
+     */
+    void agregarTiempo(MarcaTiempo tiempo) {
+        loteTiempos[enLote++] = tiempo;
+        if (enLote == TAM_LOTE) {
+            vaciarLote();
+            totalLecturas += enLote;
+            enLote = 0;
+        }
+    }
+
+    // No copiable.
+    Exportador(const Exportador&);
+    Exportador& operator=(const Exportador&);
+};
+
+/**
+ * @class ExportadorColumnar
+ * @brief Archivo binario columnar (estilo Parquet simplificado).
+ * @details Formato, en el orden de bytes del equipo:
+ * - Cabecera: "MONC", uint32 versión.
+ * - Por sensor, un fragmento de columna formado por páginas. Cada página:
+ *   uint32 n, uint32 reservado, uint64 tMin, uint64 tMax, double min,
+ *   double max; luego n uint64 de tiempos y n valores de 4 bytes
+ *   (float32 o int32).
+ * - Pie: uint32 número de sensores y, por sensor, uint16 largo del nombre,
+ *   el nombre, uint8 tipo, uint64 offset del fragmento, uint64 lecturas,
+ *   uint32 páginas, uint64 tMin, uint64 tMax, double min, double max,
+ *   double suma.
+ * - Cola: uint64 offset del pie, "MONC".
+ *
+ * Como en Parquet, las estadísticas van en el pie: se conocen al terminar
+ * cada sensor y así el archivo se escribe de corrido, sin volver atrás.
+ */
+class ExportadorColumnar : public Exportador {
+public:
+    /// @brief Versión del formato.
+    static const uint32_t VERSION = 1;
+
+private:
+    /**
+     * @struct MetaColumna
+     * @brief Estadísticas del fragmento de un sensor (para el pie).
+     */
+    struct MetaColumna {
+        char nombre[50];
+        uint8_t tipo;
+        uint64_t offset;
+        uint64_t lecturas;
+        uint32_t paginas;
+        MarcaTiempo tMin;
+        MarcaTiempo tMax;
+        double minimo;
+        double maximo;
+        double suma;
+    };
+
+    /// @brief Arreglo dinámico de metadatos por sensor.
+    MetaColumna* metas;
+    /// @brief Sensores exportados.
+    int numMetas;
+    /// @brief Capacidad de `metas`.
+    int capacidadMetas;
+
+protected:
+    void vaciarLote() override;
+    void abrirSensor() override;
+    void cerrarSensor() override;
+    void escribirPie() override;
+
+public:
+    /**
+     * @brief Constructor.
+     */
+    ExportadorColumnar();
+
+    /**
+     * @brief Destructor. Libera los metadatos.
+     */
+    ~ExportadorColumnar();
+
+    /**
+     * @brief Crea el archivo y escribe la cabecera.
+     */
+    bool abrir(const char* ruta) override;
+};
+
+/**
+ * @class ExportadorCSV
+ * @brief Archivo CSV con una fila por lectura: sensor,tipo,tiempo_ms,valor.
+ * @details Las filas se formatean directamente en el buffer del archivo.
+ * Los float se escriben con la menor precisión que los reproduce exactos.
+ * El nombre del sensor va entre comillas si contiene comas, comillas o
+ * saltos de línea (RFC 4180).
+ */
+class ExportadorCSV : public Exportador {
+protected:
+    void vaciarLote() override;
+    void abrirSensor() override {}
+    void cerrarSensor() override {}
+
+public:
+    /**
+     * @brief Crea el archivo y escribe la fila de encabezados.
+     */
+    bool abrir(const char* ruta) override;
+};
+
+#endif
@@ -0,0 +1,85 @@
+/**
+ * @file GestorEpocas.cpp
+ * @brief Implementación de la recolección por épocas.
+ */
+
+#include "GestorEpocas.h"
+#include <thread> // Para std::this_thread::yield
+
+GestorEpocas::GestorEpocas()
+    : epocaGlobal(1), retirados(nullptr), numRetirados(0), capacidadRetirados(0) {
+    for (int i = 0; i < MAX_LECTORES; i++) {
+        lectores[i].epoca.store(0, std::memory_order_relaxed);
+    }
+}
+
+GestorEpocas::~GestorEpocas() {
+    for (int i = 0; i < numRetirados; i++) {
+        retirados[i].liberar(retirados[i].objeto);
+    }
+    delete[] retirados;
+}
+
+int GestorEpocas::entrar() {
+    // Cada hilo empieza a buscar por la última ranura que usó: sin
+    // competencia, el CAS acierta al primer intento.
+    static thread_local int pista = 0;
+    for (;;) {
+        for (int k = 0; k < MAX_LECTORES; k++) {
+            int i = (pista + k) % MAX_LECTORES;
+            uint64_t libre = 0;
+            uint64_t epoca = epocaGlobal.load(std::memory_order_seq_cst);
+            if (lectores[i].epoca.compare_exchange_strong(libre, epoca + 1, std::memory_order_seq_cst)) {
+                // Ordena el registro antes de las lecturas de punteros que
+                // siguen (empareja con la barrera de recolectar()).
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                pista = i;
+                return i;
+            }
+        }
+        std::this_thread::yield(); // Todas las ranuras ocupadas
+    }
+}
+
+void GestorEpocas::salir(int ranura) {
+    lectores[ranura].epoca.store(0, std::memory_order_release);
+}
+
+void GestorEpocas::retirar(void* objeto, void (*liberar)(void*)) {
+    // Se recolecta solo al llenarse el arreglo; si un lector lento retiene
+    // los nodos, el arreglo se duplica y el costo sigue siendo O(1) amortizado.
+    if (numRetirados == capacidadRetirados) recolectar();
+    if (numRetirados == capacidadRetirados) {
+        int nuevaCapacidad = (capacidadRetirados == 0) ? CAPACIDAD_INICIAL_RETIRADOS : capacidadRetirados * 2;
+        Retirado* nuevos = new Retirado[nuevaCapacidad];
+        for (int i = 0; i < numRetirados; i++) nuevos[i] = retirados[i];
+        delete[] retirados;
+        retirados = nuevos;
+        capacidadRetirados = nuevaCapacidad;
+    }
+    retirados[numRetirados].objeto = objeto;
+    retirados[numRetirados].liberar = liberar;
+    retirados[numRetirados].epoca = epocaGlobal.fetch_add(1, std::memory_order_seq_cst);
+    numRetirados++;
+}
+
+void GestorEpocas::recolectar() {
+    // Los desenlaces anteriores quedan ordenados antes de leer las ranuras:
+    // un lector que aquí aparece libre verá los nodos ya desenlazados.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t minimaActiva = UINT64_MAX;
+    for (int i = 0; i < MAX_LECTORES; i++) {
+        uint64_t e = lectores[i].epoca.load(std::memory_order_seq_cst);
+        if (e != 0 && e - 1 < minimaActiva) minimaActiva = e - 1;
+    }
+
+    int conservados = 0;
+    for (int i = 0; i < numRetirados; i++) {
+        if (retirados[i].epoca < minimaActiva) {
+            retirados[i].liberar(retirados[i].objeto);
+        } else {
+            retirados[conservados++] = retirados[i];
+        }
+    }
+    numRetirados = conservados;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file GestorEpocas.h
+ * @brief Define la recolección por épocas usada por las estructuras concurrentes.
+ */
+#ifndef GESTOREPOCAS_H
+#define GESTOREPOCAS_H
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @class GestorEpocas
+ * @brief Difiere la liberación de nodos desenlazados hasta que ningún lector pueda verlos.
+ * @details Cada lector, al entrar, ocupa una de las MAX_LECTORES ranuras
+ * anotando la época global vigente. El escritor, al retirar un nodo ya
+ * desenlazado, lo marca con la época actual y la avanza. Un nodo retirado
+ * en la época E se libera cuando todos los lectores activos entraron en
+ * una época posterior a E: esos lectores empezaron a recorrer después del
+ * desenlace y ya no pueden alcanzarlo.
+ *
+ * Los lectores no toman locks (un CAS al entrar y un store al salir).
+ * retirar() y recolectar() solo los llama el escritor, que debe estar
+ * serializado por quien use el gestor.
+ */
+class GestorEpocas {
+public:
+    /// @brief Lectores simultáneos admitidos (si se agotan, entrar() espera).
+    static const int MAX_LECTORES = 64;
+    /// @brief Capacidad inicial del arreglo de retirados (se recolecta al llenarse).
+    static const int CAPACIDAD_INICIAL_RETIRADOS = 64;
+
+private:
+    /**
+     * @struct RanuraLector
+     * @brief Época de un lector activo (0 = ranura libre, e+1 = activo en e).
+     * @details Rellenada a 64 bytes para que cada ranura ocupe su propia
+     * línea de caché y los lectores no compitan entre sí.
+     */
+    struct RanuraLector {
+        std::atomic<uint64_t> epoca;
+        char relleno[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    /**
+     * @struct Retirado
+     * @brief Objeto desenlazado a la espera de ser liberado.
+     */
+    struct Retirado {
+        /// @brief El objeto retirado.
+        void* objeto;
+        /// @brief Función que lo libera (conoce su tipo real).
+        void (*liberar)(void*);
+        /// @brief Época en la que se retiró.
+        uint64_t epoca;
+    };
+
+    /// @brief Época global; avanza en cada retiro.
+    std::atomic<uint64_t> epocaGlobal;
+    /// @brief Ranuras de los lectores.
+    RanuraLector lectores[MAX_LECTORES];
+    /// @brief Arreglo dinámico de objetos retirados (solo lo toca el escritor).
+    Retirado* retirados;
+    /// @brief Número de objetos retirados pendientes.
+    int numRetirados;
+    /// @brief Capacidad del arreglo de retirados.
+    int capacidadRetirados;
+
+public:
+    /**
+     * @brief Constructor. Todas las ranuras libres, sin retirados.
+     */
+    GestorEpocas();
+
+    /**
+     * @brief Destructor. Libera todos los retirados (no debe haber lectores activos).
+     */
+    ~GestorEpocas();
+
+    /**
+     * @brief Registra un lector en la época vigente.
+     * @return La ranura ocupada, que debe pasarse a salir().
+     */
+    int entrar();
+
+    /**
+     * @brief Libera la ranura de un lector que terminó de recorrer.
+     */
+    void salir(int ranura);
+
+    /**
+     * @brief Retira un objeto ya desenlazado (solo el escritor).
+     * @param objeto El objeto, que ningún lector nuevo puede alcanzar.
+     * @param liberar Función que lo libera.
+     */
+    void retirar(void* objeto, void (*liberar)(void*));
+
+    /**
+     * @brief Libera los retirados que ningún lector activo puede ver (solo el escritor).
+     */
+    void recolectar();
+
+    /**
+     * @brief Obtiene el número de objetos retirados aún no liberados.
+     */
+    int getPendientes() const { return numRetirados; }
+
+private:
+    // No copiable.
+    GestorEpocas(const GestorEpocas&);
+    GestorEpocas& operator=(const GestorEpocas&);
+};
+
+#endif
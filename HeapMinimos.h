@@ -0,0 +1,206 @@
+/**
+ * @file HeapMinimos.h
+ * @brief Define el montículo binario de mínimos usado como índice de ListaSensor.
+ */
+#ifndef HEAPMINIMOS_H
+#define HEAPMINIMOS_H
+
+template <typename T> struct Nodo;
+
+/**
+ * @class HeapMinimos
+ * @brief Montículo binario de mínimos cuyas entradas son "handles" a nodos de una lista.
+ * @details Cada entrada guarda el nodo y el nodo que lo precede en la lista.
+ * Con el predecesor a mano, la lista simple puede desenlazar el mínimo en O(1)
+ * sin recorrerse desde la cabeza. Cada Nodo recuerda su posición en el
+ * arreglo (`posHeap`), lo que permite eliminar o reubicar un nodo
+ * arbitrario en O(log n).
+ * @tparam T El tipo de dato de los nodos indexados (debe soportar `operator<`).
+ */
+template <typename T>
+class HeapMinimos {
+private:
+    /**
+     * @struct Entrada
+     * @brief Un elemento del montículo.
+     */
+    struct Entrada {
+        /// @brief Nodo de la lista al que apunta esta entrada.
+        Nodo<T>* nodo;
+        /// @brief Nodo que precede a `nodo` en la lista (nullptr si es la cabeza).
+        Nodo<T>* anterior;
+    };
+
+    /// @brief Arreglo dinámico con las entradas del montículo.
+    Entrada* entradas;
+    /// @brief Número de entradas ocupadas.
+    int tamano;
+    /// @brief Capacidad reservada del arreglo.
+    int capacidad;
+
+    /**
+     * @brief Duplica la capacidad del arreglo de entradas.
+     */
+    void crecer() {
+        int nuevaCapacidad = (capacidad == 0) ? 16 : capacidad * 2;
+        Entrada* nuevas = new Entrada[nuevaCapacidad];
+        for (int i = 0; i < tamano; i++) {
+            nuevas[i] = entradas[i];
+        }
+        delete[] entradas;
+        entradas = nuevas;
+        capacidad = nuevaCapacidad;
+    }
+
+    /**
+     * @brief Coloca una entrada en la posición `i` y actualiza el nodo.
+     */
+    void colocar(int i, const Entrada& e) {
+        entradas[i] = e;
+        e.nodo->posHeap = i;
+    }
+
+    /**
+     * @brief Sube la entrada de la posición `i` mientras sea menor que su padre.
+     */
+    void subir(int i) {
+        Entrada e = entradas[i];
+        while (i > 0) {
+            int padre = (i - 1) / 2;
+            if (!(e.nodo->dato < entradas[padre].nodo->dato)) break;
+            colocar(i, entradas[padre]);
+            i = padre;
+        }
+        colocar(i, e);
+    }
+
+    /**
+     * @brief Baja la entrada de la posición `i` mientras algún hijo sea menor.
+     */
+    void bajar(int i) {
+        Entrada e = entradas[i];
+        while (true) {
+            int hijo = 2 * i + 1;
+            if (hijo >= tamano) break;
+            if (hijo + 1 < tamano && entradas[hijo + 1].nodo->dato < entradas[hijo].nodo->dato) {
+                hijo++;
+            }
+            if (!(entradas[hijo].nodo->dato < e.nodo->dato)) break;
+            colocar(i, entradas[hijo]);
+            i = hijo;
+        }
+        colocar(i, e);
+    }
+
+public:
+    /**
+     * @brief Constructor por defecto. Crea un montículo vacío.
+     */
+    HeapMinimos() : entradas(nullptr), tamano(0), capacidad(0) {}
+
+    /**
+     * @brief Destructor. Libera el arreglo (los nodos pertenecen a la lista).
+     */
+    ~HeapMinimos() {
+        delete[] entradas;
+    }
+
+    /**
+     * @brief Agrega un nodo al montículo en O(log n).
+     * @param nodo El nodo de la lista a indexar.
+     * @param anterior El nodo que lo precede en la lista (nullptr si es la cabeza).
+     */
+    void insertar(Nodo<T>* nodo, Nodo<T>* anterior) {
+        if (tamano == capacidad) crecer();
+        Entrada e;
+        e.nodo = nodo;
+        e.anterior = anterior;
+        colocar(tamano, e);
+        tamano++;
+        subir(tamano - 1);
+    }
+
+    /**
+     * @brief Agrega un nodo sin restaurar el orden del montículo.
+     * @details Pensado para construir el índice de una lista existente;
+     * debe seguirse de una llamada a reordenar().
+     */
+    void insertarSinOrdenar(Nodo<T>* nodo, Nodo<T>* anterior) {
+        if (tamano == capacidad) crecer();
+        Entrada e;
+        e.nodo = nodo;
+        e.anterior = anterior;
+        colocar(tamano, e);
+        tamano++;
+    }
+
+    /**
+     * @brief Restaura la propiedad de montículo en O(n) (heapify de Floyd).
+     */
+    void reordenar() {
+        for (int i = tamano / 2 - 1; i >= 0; i--) {
+            bajar(i);
+        }
+    }
+
+    /**
+     * @brief Obtiene el nodo con el dato mínimo en O(1).
+     * @return Puntero al nodo mínimo, o nullptr si el montículo está vacío.
+     */
+    Nodo<T>* minimo() const {
+        return (tamano > 0) ? entradas[0].nodo : nullptr;
+    }
+
+    /**
+     * @brief Obtiene el predecesor en la lista de un nodo indexado.
+     * @param nodo Un nodo presente en el montículo.
+     * @return El nodo anterior en la lista, o nullptr si es la cabeza.
+     */
+    Nodo<T>* anteriorDe(const Nodo<T>* nodo) const {
+        return entradas[nodo->posHeap].anterior;
+    }
+
+    /**
+     * @brief Actualiza el predecesor registrado para un nodo indexado.
+     * @details La lista lo llama cuando desenlaza el nodo que precedía a `nodo`.
+     */
+    void cambiarAnterior(const Nodo<T>* nodo, Nodo<T>* nuevoAnterior) {
+        entradas[nodo->posHeap].anterior = nuevoAnterior;
+    }
+
+    /**
+     * @brief Retira un nodo arbitrario del montículo en O(log n).
+     * @param nodo Un nodo presente en el montículo.
+     */
+    void eliminar(Nodo<T>* nodo) {
+        int i = nodo->posHeap;
+        nodo->posHeap = -1;
+        tamano--;
+        if (i == tamano) return; // Era la última entrada
+        colocar(i, entradas[tamano]);
+        if (i > 0 && entradas[i].nodo->dato < entradas[(i - 1) / 2].nodo->dato) {
+            subir(i);
+        } else {
+            bajar(i);
+        }
+    }
+
+    /**
+     * @brief Vacía el montículo sin liberar el arreglo reservado.
+     */
+    void vaciar() {
+        tamano = 0;
+    }
+
+    /**
+     * @brief Obtiene el número de nodos indexados.
+     */
+    int getTamano() const { return tamano; }
+
+private:
+    // No copiable: la lista reconstruye su índice al copiarse.
+    HeapMinimos(const HeapMinimos<T>&);
+    HeapMinimos<T>& operator=(const HeapMinimos<T>&);
+};
+
+#endif
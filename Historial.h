@@ -0,0 +1,604 @@
+/**
+ * @file Historial.h
+ * @brief Define la clase genérica HistorialSensor, que unifica los modos de almacenamiento.
+ */
+#ifndef HISTORIAL_H
+#define HISTORIAL_H
+
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+#include "ListaSensor.h"
+#include "ListaSensorConcurrente.h"
+#include "IndiceTemporal.h"
+#include "SerieComprimida.h"
+#include "Rollup.h"
+#include "Tiempo.h"
+
+/**
+ * @enum ModoHistorial
+ * @brief Estructura usada por un sensor para guardar sus lecturas.
+ */
+enum ModoHistorial {
+    /// @brief ListaSensor<Lectura<T>>: un Nodo por lectura, eliminación de mínimos en O(log n).
+    HISTORIAL_LISTA,
+    /// @brief SerieComprimida<T>: bloques codificados, ~10x menos memoria en retenciones largas.
+    HISTORIAL_COMPRIMIDO,
+    /// @brief ListaSensorConcurrente<Lectura<T>>: consultas desde otros hilos sin locks.
+    /// @details Límite: extraerMinimo() es O(n) y detiene el ingreso mientras recorre.
+    HISTORIAL_CONCURRENTE
+};
+
+/**
+ * @class HistorialSensor
+ * @brief Historial de lecturas de un sensor, con el modo elegido al construirlo.
+ * @details Los sensores concretos delegan aquí el almacenamiento para no
+ * repetir la selección de modo en cada método. Cada lectura lleva su marca
+ * de tiempo: en modo comprimido va en una columna aparte dentro de cada
+ * bloque; en modo lista va en el nodo y un IndiceTemporal permite ubicar
+ * rangos por búsqueda binaria. Mantiene la suma de las lecturas vivas para
+ * que los promedios no requieran recorrer el historial. Solo se reservan
+ * las estructuras del modo elegido, detrás de un único puntero (`almacen`).
+ *
+ * Solo se conservan crudas las últimas `retencion` lecturas: al ingresar,
+ * las más antiguas se compactan en RollupsSensor (cubetas de 1 minuto y
+ * 1 hora). En modo comprimido la compactación es por bloques completos,
+ * así que quedan entre `retencion` y `retencion` + 1024 lecturas crudas;
+ * en modo concurrente es por lotes (ver compactarConcurrente()).
+ *
+ * En modo concurrente las escrituras (agregar, extraerMinimo, compactación)
+ * pueden venir de varios hilos y se serializan con `mutexEscritura`. Las
+ * consultas (agregarRango, agregarTotal, getTamano, getSuma, bytesUsados)
+ * son seguras desde cualquier hilo y no toman ningún lock: los rollups se
+ * publican como un Resumen inmutable (se copia en cada compactación y el
+ * anterior se libera por épocas), y el Resumen, la suma y la cantidad de
+ * crudas se leen juntos con un seqlock (`version`). Los demás modos no
+ * toman el mutex y sus consultas deben hacerse desde el hilo que ingresa.
+ * Límite del modo concurrente: no hay índice de mínimos ni de tiempo, así
+ * que extraerMinimo() recorre las crudas en O(n) con el ingreso detenido y
+ * agregarRango() recorre las crudas en O(n) (sin bloquear a nadie).
+ * @tparam T El tipo de dato de las lecturas (float o int).
+ */
+template <typename T>
+class HistorialSensor {
+public:
+    /// @brief Lecturas crudas retenidas por defecto.
+    static const int RETENCION_POR_DEFECTO = 1000000;
+    /// @brief Lecturas mínimas por compactación en modo concurrente.
+    static const int LOTE_CONCURRENTE = 1024;
+
+private:
+    /**
+     * @struct Resumen
+     * @brief Rollups publicados en modo concurrente; inmutable una vez publicado.
+     */
+    struct Resumen {
+        /// @brief Lecturas compactadas.
+        RollupsSensor rollups;
+        /// @brief Agregado de todos los rollups (agregarTotal en O(1)).
+        Agregado total;
+        /// @brief Secuencia de la última lectura compactada (las crudas la superan).
+        uint64_t compactadasHasta;
+
+        Resumen() : compactadasHasta(0) {}
+    };
+
+    /**
+     * @struct AlmacenLista
+     * @brief Estructuras del modo HISTORIAL_LISTA.
+     */
+    struct AlmacenLista {
+        /// @brief Un Nodo por lectura cruda.
+        ListaSensor<Lectura<T> > nodos;
+        /// @brief Directorio por tiempo sobre `nodos`.
+        IndiceTemporal<T> indiceTiempo;
+        /// @brief Niveles de 1 minuto y 1 hora con las lecturas compactadas.
+        RollupsSensor rollups;
+    };
+
+    /**
+     * @struct AlmacenComprimido
+     * @brief Estructuras del modo HISTORIAL_COMPRIMIDO.
+     */
+    struct AlmacenComprimido {
+        /// @brief Bloques codificados con las lecturas crudas.
+        SerieComprimida<T> serie;
+        /// @brief Niveles de 1 minuto y 1 hora con las lecturas compactadas.
+        RollupsSensor rollups;
+    };
+
+    /**
+     * @struct AlmacenConcurrente
+     * @brief Estructuras del modo HISTORIAL_CONCURRENTE.
+     */
+    struct AlmacenConcurrente {
+        /// @brief Lecturas crudas, legibles sin locks.
+        ListaSensorConcurrente<Lectura<T> > nodos;
+        /// @brief Serializa a los escritores.
+        std::mutex mutexEscritura;
+        /// @brief Rollups publicados.
+        std::atomic<Resumen*> resumen;
+        /// @brief Lecturas crudas contadas en `suma`.
+        std::atomic<int> crudas;
+        /// @brief Seqlock sobre `suma`, `crudas` y `resumen`: impar mientras se modifican.
+        std::atomic<uint32_t> version;
+
+        AlmacenConcurrente() : resumen(new Resumen()), crudas(0), version(0) {}
+
+        /// @brief Libera el Resumen vigente; los retirados los libera `nodos`.
+        ~AlmacenConcurrente() { delete resumen.load(std::memory_order_relaxed); }
+    };
+
+    /// @brief Modo de almacenamiento elegido.
+    ModoHistorial modo;
+    /**
+     * @brief Estructuras del modo elegido; `modo` indica qué puntero es el válido.
+     * @details Un único puntero propio en lugar de las tres estructuras
+     * embebidas: un sensor no paga la lista, el índice ni el mutex de los
+     * modos que no usa, y la Celda de RegistroSensores queda chica.
+     */
+    union {
+        AlmacenLista* lista;
+        AlmacenComprimido* comprimido;
+        AlmacenConcurrente* concurrente;
+    } almacen;
+    /// @brief Suma acumulada de las lecturas crudas vivas (double; atómica para leerla sin locks).
+    std::atomic<double> suma;
+    /// @brief Máximo de lecturas crudas antes de compactar (0 = sin límite).
+    int retencion;
+
+    /**
+     * @brief Toma `mutexEscritura` solo en modo concurrente.
+     * @return El lock (se libera al salir del ámbito).
+     */
+    std::unique_lock<std::mutex> bloquear() {
+        if (modo == HISTORIAL_CONCURRENTE) return std::unique_lock<std::mutex>(almacen.concurrente->mutexEscritura);
+        return std::unique_lock<std::mutex>();
+    }
+
+    /**
+     * @brief Suma `delta` a `suma` (solo los escritores).
+     * @details Los stores dentro del seqlock son `release` para que un lector
+     * que vea el valor nuevo vea también `version` impar (sin fences).
+     */
+    void ajustarSuma(double delta) {
+        suma.store(suma.load(std::memory_order_relaxed) + delta, std::memory_order_release);
+    }
+
+    /**
+     * @brief Abre una escritura del seqlock (`version` queda impar).
+     */
+    void abrirEscritura() {
+        std::atomic<uint32_t>& version = almacen.concurrente->version;
+        version.store(version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Cierra una escritura del seqlock (`version` vuelve a ser par).
+     */
+    void cerrarEscritura() {
+        std::atomic<uint32_t>& version = almacen.concurrente->version;
+        version.store(version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Lee juntos el Resumen, la cantidad de crudas y su suma (modo concurrente).
+     * @details El llamador debe estar dentro de una época (con una
+     * Instantanea abierta) para que el Resumen no se libere mientras lo usa.
+     */
+    const Resumen* leerResumen(int& cantidad, double& total) const {
+        const AlmacenConcurrente* c = almacen.concurrente;
+        while (true) {
+            uint32_t v = c->version.load(std::memory_order_acquire);
+            const Resumen* r = c->resumen.load(std::memory_order_acquire);
+            cantidad = c->crudas.load(std::memory_order_acquire);
+            total = suma.load(std::memory_order_acquire);
+            if ((v & 1) == 0 && c->version.load(std::memory_order_relaxed) == v) return r;
+        }
+    }
+
+    /**
+     * @brief Libera un Resumen retirado (función de liberación del GestorEpocas).
+     */
+    static void liberarResumen(void* r) {
+        delete static_cast<Resumen*>(r);
+    }
+
+    /**
+     * @brief Compacta por lotes las lecturas crudas que exceden la retención (modo concurrente).
+     * @details Para no copiar los rollups en cada ingreso, solo compacta
+     * cuando las crudas superan `retencion` + lote, con un lote de al menos
+     * LOTE_CONCURRENTE lecturas y no menor que el número de cubetas, así que
+     * la copia cuesta O(1) amortizado por lectura. Primero publica el nuevo
+     * Resumen (con `compactadasHasta` en la última lectura compactada) y
+     * recién después desenlaza esas lecturas: un lector que no las alcance
+     * en la lista ya ve un Resumen que las incluye.
+     * @param forzar Compactar aunque el exceso sea menor que un lote.
+     */
+    void compactarConcurrente(bool forzar) {
+        AlmacenConcurrente* c = almacen.concurrente;
+        const Resumen* actual = c->resumen.load(std::memory_order_relaxed);
+        int lote = actual->rollups.getNumCubetas();
+        if (lote < LOTE_CONCURRENTE) lote = LOTE_CONCURRENTE;
+        int exceso = c->crudas.load(std::memory_order_relaxed) - retencion;
+        if (exceso <= 0 || (!forzar && exceso <= lote)) return;
+
+        Resumen* nuevo = new Resumen(*actual);
+        double sumaCompactada = 0;
+        {
+            typename ListaSensorConcurrente<Lectura<T> >::Instantanea instantanea(c->nodos);
+            Lectura<T> lectura;
+            for (int i = 0; i < exceso && instantanea.siguiente(lectura, nuevo->compactadasHasta); i++) {
+                nuevo->rollups.compactar(lectura.tiempo, lectura.valor);
+                sumaCompactada += lectura.valor;
+            }
+        }
+        nuevo->total = Agregado();
+        nuevo->rollups.agregarTodo(nuevo->total);
+
+        abrirEscritura();
+        c->resumen.store(nuevo, std::memory_order_release);
+        c->crudas.store(c->crudas.load(std::memory_order_relaxed) - exceso, std::memory_order_release);
+        ajustarSuma(-sumaCompactada);
+        cerrarEscritura();
+
+        c->nodos.retirar(const_cast<Resumen*>(actual), &HistorialSensor<T>::liberarResumen);
+        Lectura<T> descartada;
+        for (int i = 0; i < exceso; i++) c->nodos.eliminarCabeza(descartada);
+    }
+
+    /**
+     * @brief agregarRango() en modo concurrente, sin locks y desde un único punto.
+     * @details Primero abre la instantánea (época, límite y cabeza) y
+     * después lee el Resumen. Como el escritor publica cada Resumen antes de
+     * desenlazar las lecturas que compactó, toda lectura que ya no está en
+     * la lista desde esa cabeza está en el Resumen; las que están en ambos
+     * se saltan por su secuencia. Si el Resumen ya incluye lecturas
+     * posteriores al límite de la instantánea (hubo una compactación entre
+     * ambas lecturas) se reintenta, así el resultado corresponde siempre a
+     * las lecturas hasta ese límite. Las lecturas que extraerMinimo() quita
+     * durante el recorrido pueden contarse o no, como en la Instantanea.
+     */
+    Agregado agregarRangoConcurrente(MarcaTiempo t0, MarcaTiempo t1) const {
+        const AlmacenConcurrente* c = almacen.concurrente;
+        while (true) {
+            typename ListaSensorConcurrente<Lectura<T> >::Instantanea instantanea(c->nodos);
+            const Resumen* r = c->resumen.load(std::memory_order_acquire);
+            if (r->compactadasHasta > instantanea.getLimite()) continue;
+
+            Agregado a;
+            r->rollups.agregarRango(t0, t1, a);
+            Lectura<T> lectura;
+            uint64_t secuencia;
+            while (instantanea.siguiente(lectura, secuencia)) {
+                if (secuencia <= r->compactadasHasta) continue; // Ya está en los rollups
+                if (lectura.tiempo > t1) break;
+                if (lectura.tiempo >= t0) a.acumular(lectura.valor);
+            }
+            return a;
+        }
+    }
+
+    /**
+     * @brief Compacta en los rollups las lecturas crudas que exceden la retención.
+     * @details Se llama en cada ingreso, así que el trabajo queda repartido:
+     * en modo lista sale a lo sumo un nodo por lectura; en modo comprimido un
+     * bloque cada MAX_MUESTRAS lecturas, decodificado en streaming. En modo
+     * concurrente se llama con `mutexEscritura` tomado.
+     * @param forzar En modo concurrente, compactar aunque no se complete un lote.
+     */
+    void compactar(bool forzar = false) {
+        if (retencion <= 0) return;
+        if (modo == HISTORIAL_CONCURRENTE) {
+            compactarConcurrente(forzar);
+            return;
+        }
+        if (modo == HISTORIAL_LISTA) {
+            AlmacenLista* l = almacen.lista;
+            while (l->nodos.getTamano() > retencion) {
+                l->indiceTiempo.notificarEliminacion(l->nodos.getCabeza());
+                Lectura<T> lectura = Lectura<T>();
+                if (!l->nodos.eliminarCabeza(lectura)) break;
+                ajustarSuma(-(double)lectura.valor);
+                l->rollups.compactar(lectura.tiempo, lectura.valor);
+            }
+            return;
+        }
+        SerieComprimida<T>& serie = almacen.comprimido->serie;
+        while (serie.getNumBloques() > 1 && serie.getTamano() - serie.getBloque(0)->vivas >= retencion) {
+            BloqueComprimido<T>* b = serie.extraerPrimerBloque();
+            typename Codificador<T>::Estado e;
+            CodificadorTiempos::Estado et;
+            Codificador<T>::iniciar(e);
+            CodificadorTiempos::iniciar(et);
+            LectorBits lector(b->valores.datos);
+            LectorBits lectorTiempos(b->tiempos.datos);
+            for (int i = 0; i < b->cantidad; i++) {
+                T v = Codificador<T>::decodificar(e, lector);
+                MarcaTiempo t = CodificadorTiempos::decodificar(et, lectorTiempos);
+                if (!b->estaEliminada(i)) almacen.comprimido->rollups.compactar(t, v);
+            }
+            ajustarSuma(-b->suma);
+            delete b;
+        }
+    }
+
+    /**
+     * @brief Rollups de las lecturas compactadas (modos lista y comprimido).
+     */
+    const RollupsSensor& getRollups() const {
+        return (modo == HISTORIAL_LISTA) ? almacen.lista->rollups : almacen.comprimido->rollups;
+    }
+
+public:
+    /**
+     * @brief Constructor. Reserva solo las estructuras del modo elegido.
+     * @param m El modo de almacenamiento.
+     */
+    HistorialSensor(ModoHistorial m) : modo(m), suma(0), retencion(RETENCION_POR_DEFECTO) {
+        switch (modo) {
+            case HISTORIAL_COMPRIMIDO: almacen.comprimido = new AlmacenComprimido(); break;
+            case HISTORIAL_CONCURRENTE: almacen.concurrente = new AlmacenConcurrente(); break;
+            default: almacen.lista = new AlmacenLista(); break;
+        }
+    }
+
+    /**
+     * @brief Destructor. Libera las estructuras del modo.
+     */
+    ~HistorialSensor() {
+        switch (modo) {
+            case HISTORIAL_COMPRIMIDO: delete almacen.comprimido; break;
+            case HISTORIAL_CONCURRENTE: delete almacen.concurrente; break;
+            default: delete almacen.lista; break;
+        }
+    }
+
+    /**
+     * @brief Cambia el máximo de lecturas crudas retenidas.
+     * @param maxCrudas Lecturas crudas a conservar (0 = sin límite, nunca compacta).
+     */
+    void configurarRetencion(int maxCrudas) {
+        std::unique_lock<std::mutex> lock = bloquear();
+        retencion = maxCrudas;
+        compactar(true);
+    }
+
+    /**
+     * @brief Activa el índice de mínimos (solo tiene efecto en modo lista).
+     * @details El modo comprimido localiza el mínimo con los resúmenes de bloque.
+     */
+    void activarIndiceMinimo() {
+        if (modo == HISTORIAL_LISTA) almacen.lista->nodos.activarIndiceMinimo();
+    }
+
+    /**
+     * @brief Agrega una lectura al final del historial.
+     * @param valor La lectura.
+     * @param tiempo Su marca de tiempo (no menor que la de la lectura anterior).
+     */
+    void agregar(T valor, MarcaTiempo tiempo) {
+        std::unique_lock<std::mutex> lock = bloquear();
+        if (modo != HISTORIAL_COMPRIMIDO) {
+            Lectura<T> lectura;
+            lectura.tiempo = tiempo;
+            lectura.valor = valor;
+            if (modo == HISTORIAL_CONCURRENTE) {
+                AlmacenConcurrente* c = almacen.concurrente;
+                c->nodos.insertarAlFinal(lectura);
+                abrirEscritura();
+                c->crudas.store(c->crudas.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+                ajustarSuma(valor);
+                cerrarEscritura();
+                compactar();
+                return;
+            }
+            almacen.lista->nodos.insertarAlFinal(lectura);
+            almacen.lista->indiceTiempo.registrar(almacen.lista->nodos.getCola());
+        } else {
+            almacen.comprimido->serie.agregar(valor, tiempo);
+        }
+        ajustarSuma(valor);
+        compactar();
+    }
+
+    /**
+     * @brief Elimina la lectura de menor valor.
+     * @param[out] valor Recibe la lectura eliminada.
+     * @return false si el historial estaba vacío.
+     */
+    bool extraerMinimo(T& valor) {
+        std::unique_lock<std::mutex> lock = bloquear();
+        bool ok;
+        if (modo == HISTORIAL_CONCURRENTE) {
+            Lectura<T> lectura = Lectura<T>();
+            ok = almacen.concurrente->nodos.extraerMinimo(lectura);
+            if (ok) valor = lectura.valor;
+        } else if (modo == HISTORIAL_LISTA) {
+            AlmacenLista* l = almacen.lista;
+            Nodo<Lectura<T> >* minNodo = l->nodos.getMinimo();
+            if (minNodo != nullptr) l->indiceTiempo.notificarEliminacion(minNodo);
+            Lectura<T> lectura = Lectura<T>();
+            ok = l->nodos.extraerMinimo(lectura);
+            if (ok) valor = lectura.valor;
+        } else {
+            ok = almacen.comprimido->serie.extraerMinimo(valor);
+        }
+        if (!ok) return false;
+        bool concurrente = (modo == HISTORIAL_CONCURRENTE);
+        if (concurrente) {
+            abrirEscritura();
+            std::atomic<int>& crudas = almacen.concurrente->crudas;
+            crudas.store(crudas.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+        }
+        ajustarSuma(-(double)valor);
+        if (getTamano() == 0) suma.store(0, std::memory_order_release); // Descarta el error de redondeo acumulado
+        if (concurrente) cerrarEscritura();
+        return true;
+    }
+
+    /**
+     * @brief Agrega las lecturas con marca de tiempo en [t0, t1].
+     * @details Ninguno de los dos modos recorre el historial completo: el
+     * modo comprimido busca binariamente sobre los bloques y usa sus
+     * resúmenes; el modo lista busca binariamente en el IndiceTemporal y
+     * recorre solo desde la marca más cercana hasta t1. La parte del rango
+     * que ya fue compactada se responde con las cubetas de los rollups
+     * (con la precisión del ancho de cubeta). El modo concurrente no tiene
+     * índice de tiempo: recorre una instantánea de la lista en O(n), sin
+     * bloquear al escritor, y la combina con el Resumen publicado (ver
+     * agregarRangoConcurrente()).
+     */
+    Agregado agregarRango(MarcaTiempo t0, MarcaTiempo t1) const {
+        if (modo == HISTORIAL_CONCURRENTE) return agregarRangoConcurrente(t0, t1);
+        Agregado a;
+        getRollups().agregarRango(t0, t1, a);
+        if (modo == HISTORIAL_COMPRIMIDO) {
+            a.combinar(almacen.comprimido->serie.agregarRango(t0, t1));
+            return a;
+        }
+
+        const AlmacenLista* l = almacen.lista;
+        Nodo<Lectura<T> >* actual = l->indiceTiempo.buscarDesde(t0, l->nodos.getCabeza());
+        while (actual != nullptr && actual->dato.tiempo <= t1) {
+            if (actual->dato.tiempo >= t0) a.acumular(actual->dato.valor);
+            actual = actual->siguiente;
+        }
+        return a;
+    }
+
+    /**
+     * @brief Agrega todo el historial: rollups en O(cubetas) y crudas en O(1).
+     * @details El mínimo y máximo de las crudas no se mantienen, así que
+     * el resultado solo aporta cantidad y suma de esa parte.
+     */
+    Agregado agregarTotal() const {
+        Agregado a;
+        if (modo == HISTORIAL_CONCURRENTE) {
+            // La instantánea solo sirve de protección: mantiene vivo el Resumen
+            typename ListaSensorConcurrente<Lectura<T> >::Instantanea proteccion(almacen.concurrente->nodos);
+            int cantidad;
+            double total;
+            a = leerResumen(cantidad, total)->total;
+            a.cantidad += cantidad;
+            a.suma += total;
+            return a;
+        }
+        getRollups().agregarTodo(a);
+        a.cantidad += getTamano();
+        a.suma += suma.load(std::memory_order_relaxed);
+        return a;
+    }
+
+    /**
+     * @brief Recorre las lecturas crudas en orden, sin copiarlas.
+     * @details Llama a `visitante.lectura(tiempo, valor)` por cada lectura.
+     * El recorrido queda acotado a las lecturas presentes al empezar: en
+     * modo lista y comprimido, a las primeras getTamano(); en modo
+     * concurrente, a las publicadas al tomar la instantánea. Los rollups no
+     * se recorren.
+     *
+     * Solo en modo concurrente el ingreso puede seguir desde otro hilo
+     * durante el recorrido (la instantánea no toma locks). En modo lista y
+     * comprimido el recorrido debe hacerse desde el hilo que ingresa: una
+     * inserción compite con la lectura de los nodos, la compactación libera
+     * la cabeza bajo el recorrido y SerieComprimida puede reubicar sus
+     * bloques y flujos de bits mientras un LectorSerie los lee.
+     * @tparam V Tipo con un método `lectura(MarcaTiempo, T)`.
+     */
+    template <typename V>
+    void recorrer(V& visitante) const {
+        if (modo == HISTORIAL_CONCURRENTE) {
+            typename ListaSensorConcurrente<Lectura<T> >::Instantanea instantanea(almacen.concurrente->nodos);
+            Lectura<T> lectura;
+            while (instantanea.siguiente(lectura)) {
+                visitante.lectura(lectura.tiempo, lectura.valor);
+            }
+            return;
+        }
+        int restantes = getTamano();
+        if (modo == HISTORIAL_COMPRIMIDO) {
+            LectorSerie<T> lector(almacen.comprimido->serie, true);
+            T valor;
+            while (restantes-- > 0 && lector.siguiente(valor)) {
+                visitante.lectura(lector.getTiempo(), valor);
+            }
+            return;
+        }
+        for (Nodo<Lectura<T> >* actual = almacen.lista->nodos.getCabeza(); actual != nullptr && restantes-- > 0; actual = actual->siguiente) {
+            visitante.lectura(actual->dato.tiempo, actual->dato.valor);
+        }
+    }
+
+    /**
+     * @brief Obtiene el número de lecturas crudas vivas.
+     */
+    int getTamano() const {
+        switch (modo) {
+            case HISTORIAL_COMPRIMIDO: return almacen.comprimido->serie.getTamano();
+            case HISTORIAL_CONCURRENTE: return almacen.concurrente->crudas.load(std::memory_order_acquire);
+            default: return almacen.lista->nodos.getTamano();
+        }
+    }
+
+    /**
+     * @brief Obtiene la suma de las lecturas crudas vivas en O(1).
+     */
+    double getSuma() const {
+        return suma.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Obtiene el modo de almacenamiento.
+     */
+    ModoHistorial getModo() const { return modo; }
+
+    /**
+     * @brief Acceso a la lista (solo modo HISTORIAL_LISTA).
+     */
+    const ListaSensor<Lectura<T> >& getLista() const { return almacen.lista->nodos; }
+
+    /**
+     * @brief Acceso a la serie comprimida (solo modo HISTORIAL_COMPRIMIDO).
+     */
+    const SerieComprimida<T>& getSerie() const { return almacen.comprimido->serie; }
+
+    /**
+     * @brief Acceso a la lista concurrente (solo modo HISTORIAL_CONCURRENTE).
+     */
+    const ListaSensorConcurrente<Lectura<T> >& getListaConcurrente() const { return almacen.concurrente->nodos; }
+
+    /**
+     * @brief Memoria aproximada ocupada por el historial, en bytes.
+     * @details Incluye la estructura fija del modo (el almacén al que apunta
+     * `almacen`; el HistorialSensor en sí ocupa unos 24 bytes dentro del
+     * sensor). En modo lista cuenta además los nodos, el índice de tiempo y,
+     * si está activo, el índice de mínimos.
+     */
+    long bytesUsados() const {
+        if (modo == HISTORIAL_CONCURRENTE) {
+            const AlmacenConcurrente* c = almacen.concurrente;
+            typename ListaSensorConcurrente<Lectura<T> >::Instantanea proteccion(c->nodos);
+            const Resumen* r = c->resumen.load(std::memory_order_acquire);
+            return (long)sizeof(AlmacenConcurrente)
+                   + (long)c->nodos.getTamano() * (long)sizeof(NodoConcurrente<Lectura<T> >)
+                   + (long)sizeof(Resumen) + r->rollups.bytesUsados();
+        }
+        if (modo == HISTORIAL_COMPRIMIDO) {
+            const AlmacenComprimido* s = almacen.comprimido;
+            return (long)sizeof(AlmacenComprimido) + s->serie.bytesUsados() + s->rollups.bytesUsados();
+        }
+        const AlmacenLista* l = almacen.lista;
+        long porLectura = (long)sizeof(Nodo<Lectura<T> >);
+        if (l->nodos.tieneIndiceMinimo()) porLectura += 2 * (long)sizeof(Nodo<Lectura<T> >*);
+        return (long)sizeof(AlmacenLista) + (long)l->nodos.getTamano() * porLectura
+               + l->indiceTiempo.bytesUsados() + l->rollups.bytesUsados();
+    }
+
+private:
+    // No copiable: es dueño del almacén del modo (y en modo concurrente, de su mutex).
+    HistorialSensor(const HistorialSensor&);
+    HistorialSensor& operator=(const HistorialSensor&);
+};
+
+#endif
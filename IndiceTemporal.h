@@ -0,0 +1,169 @@
+/**
+ * @file IndiceTemporal.h
+ * @brief Define el directorio de marcas que permite buscar por tiempo en una ListaSensor.
+ */
+#ifndef INDICETEMPORAL_H
+#define INDICETEMPORAL_H
+
+#include "ListaSensor.h"
+#include "Tiempo.h"
+
+/**
+ * @class IndiceTemporal
+ * @brief Directorio disperso de (tiempo, nodo) sobre una ListaSensor<Lectura<T>>.
+ * @details Cada INTERVALO inserciones se registra el nodo recién insertado.
+ * Como la lista conserva el orden de llegada, las marcas quedan ordenadas
+ * por tiempo y una búsqueda binaria entrega el nodo desde el cual recorrer
+ * un rango, sin caminar desde la cabeza. Si se elimina un nodo marcado, la
+ * marca pasa a su sucesor (la lista debe avisar con notificarEliminacion()
+ * antes de liberar el nodo).
+ * @tparam T El tipo del valor de las lecturas.
+ */
+template <typename T>
+class IndiceTemporal {
+public:
+    /// @brief Inserciones entre dos marcas consecutivas.
+    static const int INTERVALO = 64;
+
+private:
+    /**
+     * @struct Marca
+     * @brief Entrada del directorio.
+     */
+    struct Marca {
+        /// @brief Tiempo del nodo marcado (copia, para buscar sin tocar la lista).
+        MarcaTiempo tiempo;
+        /// @brief Nodo marcado.
+        Nodo<Lectura<T> >* nodo;
+    };
+
+    /// @brief Arreglo dinámico de marcas; las válidas están en [inicio, fin).
+    Marca* marcas;
+    /// @brief Primera marca válida (las del frente se descartan sin mover el arreglo).
+    int inicio;
+    /// @brief Una posición después de la última marca válida.
+    int fin;
+    /// @brief Capacidad reservada del arreglo.
+    int capacidad;
+    /// @brief Inserciones desde la última marca.
+    int contador;
+
+    /**
+     * @brief Hace lugar para una marca más al final.
+     * @details Reutiliza el hueco del frente si es grande; si no, duplica.
+     */
+    void hacerLugar() {
+        int usadas = fin - inicio;
+        bool compactar = capacidad > 0 && inicio >= capacidad / 2;
+        int nuevaCapacidad = compactar ? capacidad : ((capacidad == 0) ? 64 : capacidad * 2);
+        Marca* nuevas = (nuevaCapacidad == capacidad) ? marcas : new Marca[nuevaCapacidad];
+        for (int i = 0; i < usadas; i++) {
+            nuevas[i] = marcas[inicio + i];
+        }
+        if (nuevas != marcas) {
+            delete[] marcas;
+            marcas = nuevas;
+            capacidad = nuevaCapacidad;
+        }
+        inicio = 0;
+        fin = usadas;
+    }
+
+    /**
+     * @brief Primera marca con tiempo >= t (búsqueda binaria).
+     */
+    int cotaInferior(MarcaTiempo t) const {
+        int izq = inicio;
+        int der = fin;
+        while (izq < der) {
+            int medio = (izq + der) / 2;
+            if (marcas[medio].tiempo < t) {
+                izq = medio + 1;
+            } else {
+                der = medio;
+            }
+        }
+        return izq;
+    }
+
+public:
+    /**
+     * @brief Constructor. Crea un directorio vacío.
+     */
+    IndiceTemporal() : marcas(nullptr), inicio(0), fin(0), capacidad(0), contador(0) {}
+
+    /**
+     * @brief Destructor. Libera el arreglo (los nodos pertenecen a la lista).
+     */
+    ~IndiceTemporal() {
+        delete[] marcas;
+    }
+
+    /**
+     * @brief Registra un nodo recién insertado al final de la lista.
+     */
+    void registrar(Nodo<Lectura<T> >* nodo) {
+        if (contador++ % INTERVALO != 0) return;
+        if (fin == capacidad) hacerLugar();
+        marcas[fin].tiempo = nodo->dato.tiempo;
+        marcas[fin].nodo = nodo;
+        fin++;
+    }
+
+    /**
+     * @brief Avisa que `nodo` va a ser eliminado de la lista.
+     * @details Las marcas que apuntan a él pasan a su sucesor en O(log m).
+     * Si no hay sucesor (era la cola) esas marcas se descartan.
+     */
+    void notificarEliminacion(Nodo<Lectura<T> >* nodo) {
+        Nodo<Lectura<T> >* sucesor = nodo->siguiente;
+        for (int i = cotaInferior(nodo->dato.tiempo); i < fin && marcas[i].tiempo == nodo->dato.tiempo; i++) {
+            if (marcas[i].nodo != nodo) continue;
+            if (sucesor == nullptr) {
+                fin = i; // Las marcas posteriores también apuntaban a la cola
+                break;
+            }
+            marcas[i].nodo = sucesor;
+            marcas[i].tiempo = sucesor->dato.tiempo;
+        }
+        // Descarta marcas repetidas del frente (p. ej. al eliminar desde la cabeza)
+        while (fin - inicio > 1 && marcas[inicio].nodo == marcas[inicio + 1].nodo) {
+            inicio++;
+        }
+    }
+
+    /**
+     * @brief Obtiene el nodo desde el cual recorrer para encontrar tiempos >= t0.
+     * @param t0 Inicio del rango buscado.
+     * @param cabeza La cabeza de la lista (se usa si ninguna marca es anterior a t0).
+     * @return Un nodo cuyo tiempo es menor que t0 (o la cabeza): ningún nodo
+     * anterior a él pertenece al rango.
+     */
+    Nodo<Lectura<T> >* buscarDesde(MarcaTiempo t0, Nodo<Lectura<T> >* cabeza) const {
+        int i = cotaInferior(t0);
+        return (i > inicio) ? marcas[i - 1].nodo : cabeza;
+    }
+
+    /**
+     * @brief Vacía el directorio.
+     */
+    void vaciar() {
+        inicio = 0;
+        fin = 0;
+        contador = 0;
+    }
+
+    /**
+     * @brief Memoria ocupada por el directorio, en bytes.
+     */
+    long bytesUsados() const {
+        return (long)capacidad * (long)sizeof(Marca);
+    }
+
+private:
+    // No copiable: se reconstruye junto con la lista.
+    IndiceTemporal(const IndiceTemporal<T>&);
+    IndiceTemporal<T>& operator=(const IndiceTemporal<T>&);
+};
+
+#endif
@@ -6,6 +6,7 @@
 #define LISTASENSOR_H
 
 #include <iostream> // Solo para logs de liberación de memoria
+#include "HeapMinimos.h"
 
 /**
  * @struct Nodo
@@ -16,6 +17,9 @@ template <typename T>
 struct Nodo {
     /// @brief El dato almacenado en el nodo.
     T dato;
+    /// @brief Posición del nodo en el HeapMinimos de la lista (-1 si no está indexado).
+    /// @details Para T = float/int ocupa el relleno de alineación: el nodo sigue midiendo 16 bytes.
+    int posHeap;
     /// @brief Puntero al siguiente nodo en la lista.
     Nodo<T>* siguiente;
 
@@ -23,7 +27,7 @@ struct Nodo {
      * @brief Constructor del Nodo.
      * @param d El dato de tipo T para inicializar el nodo.
      */
-    Nodo(T d) : dato(d), siguiente(nullptr) {}
+    Nodo(T d) : dato(d), posHeap(-1), siguiente(nullptr) {}
 };
 
 /**
@@ -38,8 +42,12 @@ class ListaSensor {
 private:
     /// @brief Puntero al primer nodo (cabeza) de la lista.
     Nodo<T>* cabeza;
+    /// @brief Puntero al último nodo (cola), para insertar al final en O(1).
+    Nodo<T>* cola;
     /// @brief Contador del número de elementos en la lista.
     int tamano;
+    /// @brief Índice opcional de mínimos (nullptr si no se activó).
+    HeapMinimos<T>* indiceMinimo;
 
     /**
      * @brief Función de utilidad para copiar los nodos de otra lista.
@@ -48,12 +56,16 @@ private:
      */
     void copiarDesde(const ListaSensor<T>& otra) {
         cabeza = nullptr;
+        cola = nullptr;
         tamano = 0;
         Nodo<T>* actualOtra = otra.cabeza;
         while (actualOtra != nullptr) {
             insertarAlFinal(actualOtra->dato);
             actualOtra = actualOtra->siguiente;
         }
+        if (otra.indiceMinimo != nullptr) {
+            activarIndiceMinimo();
+        }
     }
 
     /**
@@ -68,7 +80,38 @@ private:
             delete aBorrar;
         }
         cabeza = nullptr;
+        cola = nullptr;
         tamano = 0;
+        if (indiceMinimo != nullptr) {
+            indiceMinimo->vaciar();
+        }
+    }
+
+    /**
+     * @brief Desenlaza y libera un nodo conociendo a su predecesor, en O(1)
+     * (O(log n) si el índice de mínimos está activo).
+     * @param nodo El nodo a eliminar.
+     * @param anterior El nodo que lo precede (nullptr si `nodo` es la cabeza).
+     */
+    void desenlazar(Nodo<T>* nodo, Nodo<T>* anterior) {
+        Nodo<T>* sucesor = nodo->siguiente;
+        if (anterior == nullptr) {
+            cabeza = sucesor;
+        } else {
+            anterior->siguiente = sucesor;
+        }
+        if (cola == nodo) {
+            cola = anterior;
+        }
+        if (indiceMinimo != nullptr) {
+            // El sucesor hereda al predecesor del nodo que sale
+            if (sucesor != nullptr) {
+                indiceMinimo->cambiarAnterior(sucesor, anterior);
+            }
+            indiceMinimo->eliminar(nodo);
+        }
+        delete nodo;
+        tamano--;
     }
 
 public:
@@ -76,7 +119,7 @@ public:
      * @brief Constructor por defecto.
      * @details Inicializa una lista vacía.
      */
-    ListaSensor() : cabeza(nullptr), tamano(0) {}
+    ListaSensor() : cabeza(nullptr), cola(nullptr), tamano(0), indiceMinimo(nullptr) {}
 
     /**
      * @brief Destructor (Regla de los Tres).
@@ -84,13 +127,14 @@ public:
      */
     ~ListaSensor() {
         limpiar();
+        delete indiceMinimo;
     }
 
     /**
      * @brief Constructor de Copia (Regla de los Tres).
      * @param otra La lista a copiar.
      */
-    ListaSensor(const ListaSensor<T>& otra) {
+    ListaSensor(const ListaSensor<T>& otra) : indiceMinimo(nullptr) {
         copiarDesde(otra);
     }
 
@@ -103,6 +147,8 @@ public:
     ListaSensor<T>& operator=(const ListaSensor<T>& otra) {
         if (this != &otra) { // Evitar auto-asignación
             limpiar();
+            delete indiceMinimo;
+            indiceMinimo = nullptr;
             copiarDesde(otra);
         }
         return *this;
@@ -112,21 +158,23 @@ public:
 
     /**
      * @brief Inserta un nuevo dato al final de la lista.
-     * @details Crea un nuevo nodo y lo enlaza al final.
+     * @details Crea un nuevo nodo y lo enlaza después de la cola en O(1)
+     * (O(log n) si el índice de mínimos está activo).
      * @param dato El valor de tipo T que se agregará.
      */
     void insertarAlFinal(T dato) {
         Nodo<T>* nuevo = new Nodo<T>(dato);
+        Nodo<T>* anterior = cola;
         if (cabeza == nullptr) {
             cabeza = nuevo;
         } else {
-            Nodo<T>* actual = cabeza;
-            while (actual->siguiente != nullptr) {
-                actual = actual->siguiente;
-            }
-            actual->siguiente = nuevo;
+            cola->siguiente = nuevo;
         }
+        cola = nuevo;
         tamano++;
+        if (indiceMinimo != nullptr) {
+            indiceMinimo->insertar(nuevo, anterior);
+        }
     }
 
     /**
@@ -145,14 +193,96 @@ public:
 
         if (actual == nullptr) return; // No encontrado
 
-        if (anterior == nullptr) { // Es la cabeza
-            cabeza = actual->siguiente;
-        } else { // Es un nodo intermedio
-            anterior->siguiente = actual->siguiente;
+        desenlazar(actual, anterior);
+    }
+
+    /**
+     * @brief Elimina el primer nodo (el más antiguo) en O(1).
+     * @details O(log n) si el índice de mínimos está activo.
+     * @param[out] valor Recibe el dato del nodo eliminado.
+     * @return false si la lista estaba vacía.
+     */
+    bool eliminarCabeza(T& valor) {
+        if (cabeza == nullptr) return false;
+        valor = cabeza->dato;
+        desenlazar(cabeza, nullptr);
+        return true;
+    }
+
+    // --- Índice de Mínimos ---
+
+    /**
+     * @brief Activa el índice de mínimos (HeapMinimos) sobre la lista.
+     * @details Construye el montículo con los nodos actuales en O(n). A partir
+     * de aquí cada inserción cuesta O(log n) y extraerMinimo() deja de recorrer
+     * la lista. El orden de inserción de la lista no se altera.
+     */
+    void activarIndiceMinimo() {
+        if (indiceMinimo != nullptr) return;
+        indiceMinimo = new HeapMinimos<T>();
+        Nodo<T>* anterior = nullptr;
+        Nodo<T>* actual = cabeza;
+        while (actual != nullptr) {
+            indiceMinimo->insertarSinOrdenar(actual, anterior);
+            anterior = actual;
+            actual = actual->siguiente;
+        }
+        indiceMinimo->reordenar();
+    }
+
+    /**
+     * @brief Indica si el índice de mínimos está activo.
+     */
+    bool tieneIndiceMinimo() const { return indiceMinimo != nullptr; }
+
+    /**
+     * @brief Obtiene el nodo con el dato mínimo, sin eliminarlo.
+     * @details O(1) con el índice activo; sin índice recorre la lista.
+     * @return Puntero al nodo mínimo, o nullptr si la lista está vacía.
+     */
+    Nodo<T>* getMinimo() const {
+        if (indiceMinimo != nullptr) return indiceMinimo->minimo();
+        Nodo<T>* minNodo = cabeza;
+        for (Nodo<T>* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+            if (actual->dato < minNodo->dato) minNodo = actual;
         }
+        return minNodo;
+    }
 
-        delete actual;
-        tamano--;
+    /**
+     * @brief Elimina el nodo con el dato mínimo.
+     * @details Con el índice activo cuesta O(log n): el montículo entrega el
+     * nodo y su predecesor, así que no hay que buscarlo en la lista. Sin
+     * índice, recurre a un recorrido O(n).
+     * @param[out] valor Recibe el dato del nodo eliminado.
+     * @return true si se eliminó un nodo, false si la lista estaba vacía.
+     */
+    bool extraerMinimo(T& valor) {
+        if (cabeza == nullptr) return false;
+
+        Nodo<T>* minNodo;
+        Nodo<T>* minAnterior;
+        if (indiceMinimo != nullptr) {
+            minNodo = indiceMinimo->minimo();
+            minAnterior = indiceMinimo->anteriorDe(minNodo);
+        } else {
+            minNodo = cabeza;
+            minAnterior = nullptr;
+            Nodo<T>* anterior = cabeza;
+            Nodo<T>* actual = cabeza->siguiente;
+            while (actual != nullptr) {
+                if (actual->dato < minNodo->dato) {
+                    minNodo = actual;
+                    minAnterior = anterior;
+                }
+                anterior = actual;
+                actual = actual->siguiente;
+            }
+        }
+
+        valor = minNodo->dato;
+        desenlazar(minNodo, minAnterior);
+        return true;
     }
 
     /**
@@ -160,6 +290,12 @@ public:
      * @return Puntero constante al primer nodo (Nodo<T>*).
      */
     Nodo<T>* getCabeza() const { return cabeza; }
+
+    /**
+     * @brief Obtiene el puntero a la cola (último nodo) de la lista.
+     * @return Puntero al último nodo, o nullptr si la lista está vacía.
+     */
+    Nodo<T>* getCola() const { return cola; }
     
     /**
      * @brief Obtiene el tamaño actual de la lista.
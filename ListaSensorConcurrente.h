@@ -0,0 +1,295 @@
+/**
+ * @file ListaSensorConcurrente.h
+ * @brief Define ListaSensorConcurrente: lista con un escritor y lectores sin locks.
+ */
+#ifndef LISTASENSORCONCURRENTE_H
+#define LISTASENSORCONCURRENTE_H
+
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+#include "GestorEpocas.h"
+
+/**
+ * @struct NodoConcurrente
+ * @brief Nodo de ListaSensorConcurrente.
+ * @details `dato` y `secuencia` no cambian después de publicar el nodo; solo
+ * `siguiente` se modifica (por el escritor) y por eso es atómico.
+ * @tparam T El tipo de dato almacenado.
+ */
+template <typename T>
+struct NodoConcurrente {
+    /// @brief El dato almacenado en el nodo.
+    T dato;
+    /// @brief Número de inserción (crece con cada insertarAlFinal).
+    uint64_t secuencia;
+    /// @brief Puntero al siguiente nodo en la lista.
+    std::atomic<NodoConcurrente<T>*> siguiente;
+
+    /**
+     * @brief Constructor del NodoConcurrente.
+     */
+    NodoConcurrente(const T& d, uint64_t s) : dato(d), secuencia(s), siguiente(nullptr) {}
+};
+
+/**
+ * @class ListaSensorConcurrente
+ * @brief Lista enlazada simple que se puede leer mientras otro hilo escribe.
+ * @details Las operaciones de escritura (inserción al final y eliminaciones)
+ * se serializan con un mutex propio; un nodo se publica con un store
+ * `release` sobre el `siguiente` de la cola, así que un lector que lo
+ * alcanza (con `acquire`) lo ve completo. Los lectores no toman el mutex:
+ * recorren a través de una Instantanea, que los registra en el GestorEpocas
+ * para que los nodos desenlazados mientras recorren no se liberen bajo sus
+ * pies. Un nodo desenlazado conserva su `siguiente`, así que un lector
+ * detenido en él sigue recorriendo hasta el final sin problemas.
+ *
+ * No copiable: a diferencia de ListaSensor no tiene sentido copiarla
+ * mientras otros hilos la leen.
+ * @tparam T El tipo de dato almacenado.
+ */
+template <typename T>
+class ListaSensorConcurrente {
+private:
+    /// @brief Primer nodo (los lectores parten de aquí).
+    std::atomic<NodoConcurrente<T>*> cabeza;
+    /// @brief Último nodo (solo lo usa el escritor).
+    NodoConcurrente<T>* cola;
+    /// @brief Número de elementos (lo modifica el escritor; cualquiera lo lee).
+    std::atomic<int> tamano;
+    /// @brief Secuencia del último nodo publicado (límite de las instantáneas).
+    std::atomic<uint64_t> ultimaSecuencia;
+    /// @brief Serializa a los escritores.
+    std::mutex mutexEscritura;
+    /// @brief Recolección diferida de los nodos desenlazados.
+    mutable GestorEpocas epocas;
+
+    /**
+     * @brief Libera un nodo retirado (función de liberación del GestorEpocas).
+     */
+    static void liberarNodo(void* nodo) {
+        delete static_cast<NodoConcurrente<T>*>(nodo);
+    }
+
+    /**
+     * @brief Desenlaza `nodo` y lo entrega al GestorEpocas (con el mutex tomado).
+     * @param nodo El nodo a quitar.
+     * @param anterior Su predecesor (nullptr si es la cabeza).
+     */
+    void desenlazar(NodoConcurrente<T>* nodo, NodoConcurrente<T>* anterior) {
+        NodoConcurrente<T>* sucesor = nodo->siguiente.load(std::memory_order_relaxed);
+        if (anterior == nullptr) {
+            cabeza.store(sucesor, std::memory_order_release);
+        } else {
+            anterior->siguiente.store(sucesor, std::memory_order_release);
+        }
+        if (nodo == cola) cola = anterior;
+        tamano.store(tamano.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+        epocas.retirar(nodo, &ListaSensorConcurrente<T>::liberarNodo);
+    }
+
+public:
+    /**
+     * @class Instantanea
+     * @brief Recorrido sin locks de la lista tal como estaba al crearla.
+     * @details Solo devuelve los nodos insertados antes de crearse (los
+     * posteriores se cortan por su secuencia). Un nodo eliminado durante el
+     * recorrido puede aparecer o no, según si el lector ya lo había
+     * alcanzado. Mientras exista, los nodos que vio no se liberan, así que
+     * conviene que viva poco.
+     */
+    class Instantanea {
+    private:
+        /// @brief La lista recorrida.
+        const ListaSensorConcurrente<T>& lista;
+        /// @brief Ranura ocupada en el GestorEpocas.
+        int ranura;
+        /// @brief Secuencia máxima incluida.
+        uint64_t limite;
+        /// @brief Próximo nodo a devolver.
+        NodoConcurrente<T>* actual;
+
+    public:
+        /**
+         * @brief Constructor. Entra en la época vigente y fija el límite.
+         */
+        Instantanea(const ListaSensorConcurrente<T>& l) : lista(l) {
+            ranura = lista.epocas.entrar();
+            limite = lista.ultimaSecuencia.load(std::memory_order_acquire);
+            actual = lista.cabeza.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Destructor. Sale de la época (los retirados pueden liberarse).
+         */
+        ~Instantanea() {
+            lista.epocas.salir(ranura);
+        }
+
+        /**
+         * @brief Obtiene el siguiente dato de la instantánea.
+         * @param[out] dato Recibe el dato.
+         * @return false al llegar al final.
+         */
+        bool siguiente(T& dato) {
+            if (actual == nullptr || actual->secuencia > limite) return false;
+            dato = actual->dato;
+            actual = actual->siguiente.load(std::memory_order_acquire);
+            return true;
+        }
+
+        /**
+         * @brief Como siguiente(T&), pero también devuelve la secuencia del nodo.
+         * @param[out] dato Recibe el dato.
+         * @param[out] secuencia Recibe su número de inserción.
+         * @return false al llegar al final.
+         */
+        bool siguiente(T& dato, uint64_t& secuencia) {
+            if (actual == nullptr || actual->secuencia > limite) return false;
+            secuencia = actual->secuencia;
+            return siguiente(dato);
+        }
+
+        /**
+         * @brief Obtiene la secuencia máxima incluida en la instantánea.
+         */
+        uint64_t getLimite() const { return limite; }
+
+    private:
+        // No copiable: ocupa una ranura del GestorEpocas.
+        Instantanea(const Instantanea&);
+        Instantanea& operator=(const Instantanea&);
+    };
+
+    /**
+     * @brief Constructor. Crea una lista vacía.
+     */
+    ListaSensorConcurrente() : cabeza(nullptr), cola(nullptr), tamano(0), ultimaSecuencia(0) {}
+
+    /**
+     * @brief Destructor. Libera todos los nodos (no debe haber lectores activos).
+     */
+    ~ListaSensorConcurrente() {
+        NodoConcurrente<T>* actual = cabeza.load(std::memory_order_relaxed);
+        while (actual != nullptr) {
+            NodoConcurrente<T>* aBorrar = actual;
+            actual = actual->siguiente.load(std::memory_order_relaxed);
+            delete aBorrar;
+        }
+        // Los nodos retirados los libera el destructor de 'epocas'.
+    }
+
+    /**
+     * @brief Inserta un nuevo elemento al final de la lista en O(1).
+     * @param valor El dato a insertar.
+     */
+    void insertarAlFinal(const T& valor) {
+        std::lock_guard<std::mutex> lock(mutexEscritura);
+        uint64_t secuencia = ultimaSecuencia.load(std::memory_order_relaxed) + 1;
+        NodoConcurrente<T>* nuevoNodo = new NodoConcurrente<T>(valor, secuencia);
+        if (cola == nullptr) {
+            cabeza.store(nuevoNodo, std::memory_order_release);
+        } else {
+            cola->siguiente.store(nuevoNodo, std::memory_order_release);
+        }
+        cola = nuevoNodo;
+        tamano.store(tamano.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        ultimaSecuencia.store(secuencia, std::memory_order_release);
+    }
+
+    /**
+     * @brief Elimina la primera aparición de un valor.
+     * @param valor El valor a eliminar (se compara con operator!=).
+     * @return true si se eliminó, false si no se encontró.
+     */
+    bool eliminarValor(const T& valor) {
+        std::lock_guard<std::mutex> lock(mutexEscritura);
+        NodoConcurrente<T>* anterior = nullptr;
+        NodoConcurrente<T>* actual = cabeza.load(std::memory_order_relaxed);
+        while (actual != nullptr && actual->dato != valor) {
+            anterior = actual;
+            actual = actual->siguiente.load(std::memory_order_relaxed);
+        }
+        if (actual == nullptr) return false;
+        desenlazar(actual, anterior);
+        return true;
+    }
+
+    /**
+     * @brief Elimina el primer elemento en O(1).
+     * @param[out] valor Recibe el dato eliminado.
+     * @return false si la lista estaba vacía.
+     */
+    bool eliminarCabeza(T& valor) {
+        std::lock_guard<std::mutex> lock(mutexEscritura);
+        NodoConcurrente<T>* primero = cabeza.load(std::memory_order_relaxed);
+        if (primero == nullptr) return false;
+        valor = primero->dato;
+        desenlazar(primero, nullptr);
+        return true;
+    }
+
+    /**
+     * @brief Elimina el menor elemento (según operator<) en O(n).
+     * @details No hay HeapMinimos: sus posiciones viven en los nodos y
+     * cambian en cada reordenamiento, lo que obligaría a sincronizarlas.
+     * Es un límite de esta lista: el recorrido se hace con `mutexEscritura`
+     * tomado, así que el ingreso queda detenido durante O(n) (unos 6 ms con
+     * un millón de nodos). Los lectores no se ven afectados.
+     * @param[out] valor Recibe el dato eliminado.
+     * @return false si la lista estaba vacía.
+     */
+    bool extraerMinimo(T& valor) {
+        std::lock_guard<std::mutex> lock(mutexEscritura);
+        NodoConcurrente<T>* minimo = cabeza.load(std::memory_order_relaxed);
+        if (minimo == nullptr) return false;
+        NodoConcurrente<T>* anteriorMinimo = nullptr;
+        NodoConcurrente<T>* anterior = minimo;
+        NodoConcurrente<T>* actual = minimo->siguiente.load(std::memory_order_relaxed);
+        while (actual != nullptr) {
+            if (actual->dato < minimo->dato) {
+                minimo = actual;
+                anteriorMinimo = anterior;
+            }
+            anterior = actual;
+            actual = actual->siguiente.load(std::memory_order_relaxed);
+        }
+        valor = minimo->dato;
+        desenlazar(minimo, anteriorMinimo);
+        return true;
+    }
+
+    /**
+     * @brief Entrega al GestorEpocas de la lista un objeto externo ya despublicado.
+     * @details Permite que quien usa la lista publique junto a ella otras
+     * estructuras (p. ej. los rollups de HistorialSensor) y las libere con
+     * la misma protección: las Instantaneas abiertas las mantienen vivas.
+     * @param objeto El objeto, que ningún lector nuevo puede alcanzar ya.
+     * @param liberar Función que lo libera.
+     */
+    void retirar(void* objeto, void (*liberar)(void*)) {
+        std::lock_guard<std::mutex> lock(mutexEscritura);
+        epocas.retirar(objeto, liberar);
+    }
+
+    /**
+     * @brief Obtiene el número de elementos (seguro desde cualquier hilo).
+     */
+    int getTamano() const {
+        return tamano.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Obtiene el número de nodos desenlazados aún no liberados.
+     */
+    int getPendientes() const {
+        return epocas.getPendientes();
+    }
+
+private:
+    // No copiable.
+    ListaSensorConcurrente(const ListaSensorConcurrente&);
+    ListaSensorConcurrente& operator=(const ListaSensorConcurrente&);
+};
+
+#endif
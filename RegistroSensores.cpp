@@ -0,0 +1,118 @@
+/**
+ * @file RegistroSensores.cpp
+ * @brief Implementación del registro contiguo de sensores.
+ */
+
+#include "RegistroSensores.h"
+
+RegistroSensores::RegistroSensores()
+    : bloquesArena(nullptr), numBloquesArena(0), ranuras(nullptr), numRanuras(0), primeraLibre(-1),
+      densos(nullptr), ranuraDeDenso(nullptr), tamano(0), capacidad(0) {}
+
+RegistroSensores::~RegistroSensores() {
+    // Destrucción virtual explícita: la memoria es de la arena, no se hace delete
+    for (int i = 0; i < tamano; i++) {
+        densos[i]->~SensorBase();
+    }
+    for (int b = 0; b < numBloquesArena; b++) {
+        delete[] bloquesArena[b];
+    }
+    delete[] bloquesArena;
+    delete[] ranuras;
+    delete[] densos;
+    delete[] ranuraDeDenso;
+}
+
+int RegistroSensores::reservarRanura() {
+    if (primeraLibre != -1) {
+        int ranura = primeraLibre;
+        primeraLibre = ranuras[ranura].siguienteLibre;
+        return ranura;
+    }
+
+    if (numRanuras == capacidad) {
+        // Crecen juntos los arreglos indexados por ranura y los densos
+        int nuevaCapacidad = (capacidad == 0) ? CELDAS_POR_BLOQUE : capacidad * 2;
+        Ranura* nuevasRanuras = new Ranura[nuevaCapacidad];
+        SensorBase** nuevosDensos = new SensorBase*[nuevaCapacidad];
+        int* nuevasRanurasDeDenso = new int[nuevaCapacidad];
+        for (int i = 0; i < numRanuras; i++) nuevasRanuras[i] = ranuras[i];
+        for (int i = 0; i < tamano; i++) {
+            nuevosDensos[i] = densos[i];
+            nuevasRanurasDeDenso[i] = ranuraDeDenso[i];
+        }
+        delete[] ranuras;
+        delete[] densos;
+        delete[] ranuraDeDenso;
+        ranuras = nuevasRanuras;
+        densos = nuevosDensos;
+        ranuraDeDenso = nuevasRanurasDeDenso;
+
+        // La arena crece por bloques: las celdas existentes no se mueven
+        int nuevosBloques = nuevaCapacidad / CELDAS_POR_BLOQUE;
+        Celda** nuevaArena = new Celda*[nuevosBloques];
+        for (int b = 0; b < numBloquesArena; b++) nuevaArena[b] = bloquesArena[b];
+        for (int b = numBloquesArena; b < nuevosBloques; b++) nuevaArena[b] = new Celda[CELDAS_POR_BLOQUE];
+        delete[] bloquesArena;
+        bloquesArena = nuevaArena;
+        numBloquesArena = nuevosBloques;
+
+        capacidad = nuevaCapacidad;
+    }
+
+    int ranura = numRanuras++;
+    ranuras[ranura].generacion = 1;
+    ranuras[ranura].denso = -1;
+    ranuras[ranura].siguienteLibre = -1;
+    return ranura;
+}
+
+ManejadorSensor RegistroSensores::publicar(int ranura, SensorBase* sensor) {
+    densos[tamano] = sensor;
+    ranuraDeDenso[tamano] = ranura;
+    ranuras[ranura].denso = tamano;
+    tamano++;
+
+    ManejadorSensor h;
+    h.indice = (uint32_t)ranura;
+    h.generacion = ranuras[ranura].generacion;
+    return h;
+}
+
+bool RegistroSensores::eliminar(ManejadorSensor h) {
+    SensorBase* sensor = obtener(h);
+    if (sensor == nullptr) return false;
+
+    int ranura = (int)h.indice;
+    int pos = ranuras[ranura].denso;
+    sensor->~SensorBase();
+
+    // El último sensor denso ocupa el hueco (sin re-enlazar nada)
+    int ultimo = tamano - 1;
+    densos[pos] = densos[ultimo];
+    ranuraDeDenso[pos] = ranuraDeDenso[ultimo];
+    ranuras[ranuraDeDenso[pos]].denso = pos;
+    tamano--;
+
+    // Invalida los manejadores existentes y recicla la ranura
+    ranuras[ranura].generacion++;
+    if (ranuras[ranura].generacion == 0) ranuras[ranura].generacion = 1;
+    ranuras[ranura].denso = -1;
+    ranuras[ranura].siguienteLibre = primeraLibre;
+    primeraLibre = ranura;
+    return true;
+}
+
+SensorBase* RegistroSensores::obtener(ManejadorSensor h) const {
+    if (!h.esValido() || (int)h.indice >= numRanuras) return nullptr;
+    const Ranura& r = ranuras[h.indice];
+    if (r.generacion != h.generacion || r.denso == -1) return nullptr;
+    return densos[r.denso];
+}
+
+ManejadorSensor RegistroSensores::manejadorDe(int i) const {
+    ManejadorSensor h;
+    h.indice = (uint32_t)ranuraDeDenso[i];
+    h.generacion = ranuras[h.indice].generacion;
+    return h;
+}
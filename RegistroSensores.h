@@ -0,0 +1,170 @@
+/**
+ * @file RegistroSensores.h
+ * @brief Define el registro contiguo de sensores (slot map + arena) usado por Sistema.
+ */
+#ifndef REGISTROSENSORES_H
+#define REGISTROSENSORES_H
+
+#include "Sensor.h"
+#include <stdint.h>
+#include <new> // Para placement new
+
+/**
+ * @struct ManejadorSensor
+ * @brief Referencia estable a un sensor del registro.
+ * @details A diferencia de un puntero, detecta si el sensor fue eliminado:
+ * la generación del manejador deja de coincidir con la de la ranura.
+ */
+struct ManejadorSensor {
+    /// @brief Ranura del sensor en el registro.
+    uint32_t indice;
+    /// @brief Generación de la ranura cuando se creó el sensor (0 = inválido).
+    uint32_t generacion;
+
+    /**
+     * @brief Constructor. Crea un manejador inválido.
+     */
+    ManejadorSensor() : indice(0), generacion(0) {}
+
+    /**
+     * @brief Indica si el manejador apunta (o apuntó) a algún sensor.
+     */
+    bool esValido() const { return generacion != 0; }
+};
+
+/**
+ * @class RegistroSensores
+ * @brief Mapa de ranuras con generaciones sobre una arena contigua de sensores.
+ * @details Los objetos sensor se construyen (placement new) en celdas de una
+ * arena reservada por bloques de CELDAS_POR_BLOQUE, así que sensores
+ * vecinos quedan contiguos en memoria y su dirección no cambia al crecer.
+ * La celda de la arena coincide con la ranura, de modo que una sola lista
+ * de ranuras libres recicla ambas. Para recorrer, un arreglo denso guarda
+ * los sensores vivos sin huecos; eliminar un sensor mueve el último del
+ * arreglo denso a su lugar, todo en O(1).
+ */
+class RegistroSensores {
+public:
+    /// @brief Celdas de arena reservadas de una vez.
+    static const int CELDAS_POR_BLOQUE = 64;
+
+private:
+    /**
+     * @struct Celda
+     * @brief Espacio para cualquier sensor concreto.
+     */
+    struct Celda {
+        alignas((alignof(SensorTemperatura) > alignof(SensorPresion)) ? alignof(SensorTemperatura) : alignof(SensorPresion))
+        unsigned char bytes[(sizeof(SensorTemperatura) > sizeof(SensorPresion)) ? sizeof(SensorTemperatura) : sizeof(SensorPresion)];
+    };
+
+    /**
+     * @struct Ranura
+     * @brief Entrada del mapa de ranuras.
+     */
+    struct Ranura {
+        /// @brief Generación actual (se incrementa al liberar la ranura).
+        uint32_t generacion;
+        /// @brief Posición del sensor en el arreglo denso (-1 si está libre).
+        int denso;
+        /// @brief Siguiente ranura libre (-1 si no hay más).
+        int siguienteLibre;
+    };
+
+    /// @brief Bloques de la arena (cada uno con CELDAS_POR_BLOQUE celdas).
+    Celda** bloquesArena;
+    /// @brief Número de bloques de arena reservados.
+    int numBloquesArena;
+    /// @brief Arreglo de ranuras (una por celda de la arena).
+    Ranura* ranuras;
+    /// @brief Número de ranuras creadas.
+    int numRanuras;
+    /// @brief Primera ranura libre (-1 si no hay).
+    int primeraLibre;
+    /// @brief Arreglo denso de sensores vivos.
+    SensorBase** densos;
+    /// @brief Ranura de cada entrada de `densos`.
+    int* ranuraDeDenso;
+    /// @brief Número de sensores vivos.
+    int tamano;
+    /// @brief Capacidad de `ranuras`, `densos` y `ranuraDeDenso`.
+    int capacidad;
+
+    /**
+     * @brief Obtiene la dirección de la celda de arena de una ranura.
+     */
+    void* celda(int ranura) const {
+        return bloquesArena[ranura / CELDAS_POR_BLOQUE][ranura % CELDAS_POR_BLOQUE].bytes;
+    }
+
+    /**
+     * @brief Reserva una ranura (y su celda) libre, creciendo si hace falta.
+     * @return El índice de la ranura.
+     */
+    int reservarRanura();
+
+    /**
+     * @brief Registra en el arreglo denso el sensor recién construido.
+     */
+    ManejadorSensor publicar(int ranura, SensorBase* sensor);
+
+public:
+    /**
+     * @brief Constructor. Crea un registro vacío.
+     */
+    RegistroSensores();
+
+    /**
+     * @brief Destructor. Destruye los sensores vivos y libera la arena.
+     */
+    ~RegistroSensores();
+
+    /**
+     * @brief Construye un sensor de tipo S dentro de la arena.
+     * @tparam S SensorTemperatura o SensorPresion.
+     * @param nombre El nombre (ID) del sensor.
+     * @param modo Estructura del historial del sensor.
+     * @return El manejador del nuevo sensor.
+     */
+    template <typename S>
+    ManejadorSensor crear(const char* nombre, ModoHistorial modo) {
+        static_assert(sizeof(S) <= sizeof(Celda), "El sensor no cabe en una celda de la arena");
+        int ranura = reservarRanura();
+        S* sensor = new (celda(ranura)) S(nombre, modo);
+        return publicar(ranura, sensor);
+    }
+
+    /**
+     * @brief Destruye un sensor y libera su ranura en O(1).
+     * @return false si el manejador ya no es válido.
+     */
+    bool eliminar(ManejadorSensor h);
+
+    /**
+     * @brief Obtiene el sensor de un manejador.
+     * @return El sensor, o nullptr si fue eliminado.
+     */
+    SensorBase* obtener(ManejadorSensor h) const;
+
+    /**
+     * @brief Obtiene el manejador del sensor en la posición densa `i`.
+     */
+    ManejadorSensor manejadorDe(int i) const;
+
+    /**
+     * @brief Obtiene el sensor en la posición densa `i` (0 <= i < getTamano()).
+     */
+    SensorBase* getDenso(int i) const { return densos[i]; }
+
+    /**
+     * @brief Obtiene el número de sensores vivos.
+     */
+    int getTamano() const { return tamano; }
+
+private:
+    // No copiable: los sensores viven en la arena del registro.
+    RegistroSensores(const RegistroSensores&);
+    RegistroSensores& operator=(const RegistroSensores&);
+};
+
+#endif
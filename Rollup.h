@@ -0,0 +1,268 @@
+/**
+ * @file Rollup.h
+ * @brief Define los niveles de agregación (rollups) para lecturas antiguas.
+ */
+#ifndef ROLLUP_H
+#define ROLLUP_H
+
+#include "Tiempo.h"
+
+/**
+ * @struct Cubeta
+ * @brief Resumen de todas las lecturas de un intervalo de tiempo.
+ */
+struct Cubeta {
+    /// @brief Inicio del intervalo (múltiplo del ancho del nivel).
+    MarcaTiempo inicio;
+    /// @brief Cantidad, suma, mínimo y máximo de las lecturas del intervalo.
+    Agregado agregado;
+};
+
+/**
+ * @class NivelRollup
+ * @brief Secuencia de cubetas de ancho fijo, ordenadas por tiempo.
+ * @details Las cubetas se agregan al final y, si el nivel tiene un máximo,
+ * las más antiguas se retiran por el frente para pasar al nivel siguiente.
+ * Las válidas ocupan [inicio, fin) del arreglo, como en IndiceTemporal.
+ * Cumple con la Regla de los Tres: la copia reserva solo las cubetas
+ * válidas (HistorialSensor copia los rollups en modo concurrente).
+ */
+class NivelRollup {
+private:
+    /// @brief Ancho de cada cubeta, en milisegundos.
+    MarcaTiempo anchoMs;
+    /// @brief Máximo de cubetas antes de retirar las antiguas (0 = sin límite).
+    int maxCubetas;
+    /// @brief Arreglo dinámico de cubetas.
+    Cubeta* cubetas;
+    /// @brief Primera cubeta válida.
+    int inicio;
+    /// @brief Una posición después de la última cubeta válida.
+    int fin;
+    /// @brief Capacidad reservada del arreglo.
+    int capacidad;
+
+    /**
+     * @brief Hace lugar para una cubeta más al final.
+     * @details Reutiliza el hueco del frente si es grande; si no, duplica.
+     */
+    void hacerLugar() {
+        int usadas = fin - inicio;
+        bool compactar = inicio > 0 && inicio >= capacidad / 2;
+        int nuevaCapacidad = compactar ? capacidad : ((capacidad == 0) ? 16 : capacidad * 2);
+        Cubeta* nuevas = compactar ? cubetas : new Cubeta[nuevaCapacidad];
+        for (int i = 0; i < usadas; i++) {
+            nuevas[i] = cubetas[inicio + i];
+        }
+        if (nuevas != cubetas) {
+            delete[] cubetas;
+            cubetas = nuevas;
+            capacidad = nuevaCapacidad;
+        }
+        inicio = 0;
+        fin = usadas;
+    }
+
+    /**
+     * @brief Copia las cubetas válidas de otro nivel (el arreglo propio debe estar libre).
+     */
+    void copiarDesde(const NivelRollup& otro) {
+        int usadas = otro.fin - otro.inicio;
+        capacidad = usadas;
+        cubetas = (usadas > 0) ? new Cubeta[usadas] : nullptr;
+        for (int i = 0; i < usadas; i++) {
+            cubetas[i] = otro.cubetas[otro.inicio + i];
+        }
+        inicio = 0;
+        fin = usadas;
+    }
+
+public:
+    /**
+     * @brief Constructor.
+     * @param ancho Ancho de cada cubeta, en milisegundos.
+     * @param maximo Máximo de cubetas retenidas (0 = sin límite).
+     */
+    NivelRollup(MarcaTiempo ancho, int maximo)
+        : anchoMs(ancho), maxCubetas(maximo), cubetas(nullptr), inicio(0), fin(0), capacidad(0) {}
+
+    /**
+     * @brief Constructor de copia. Copia solo las cubetas válidas.
+     */
+    NivelRollup(const NivelRollup& otro)
+        : anchoMs(otro.anchoMs), maxCubetas(otro.maxCubetas), cubetas(nullptr), inicio(0), fin(0), capacidad(0) {
+        copiarDesde(otro);
+    }
+
+    /**
+     * @brief Operador de asignación.
+     */
+    NivelRollup& operator=(const NivelRollup& otro) {
+        if (this != &otro) {
+            delete[] cubetas;
+            anchoMs = otro.anchoMs;
+            maxCubetas = otro.maxCubetas;
+            cubetas = nullptr;
+            capacidad = 0;
+            copiarDesde(otro);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destructor. Libera el arreglo de cubetas.
+     */
+    ~NivelRollup() {
+        delete[] cubetas;
+    }
+
+    /**
+     * @brief Acumula un agregado con marca de tiempo `t` en la cubeta que le corresponde.
+     * @details Los tiempos deben llegar en orden no decreciente.
+     */
+    void acumular(MarcaTiempo t, const Agregado& a) {
+        MarcaTiempo inicioCubeta = t - t % anchoMs;
+        if (fin == inicio || cubetas[fin - 1].inicio != inicioCubeta) {
+            if (fin == capacidad) hacerLugar();
+            cubetas[fin].inicio = inicioCubeta;
+            cubetas[fin].agregado = Agregado();
+            fin++;
+        }
+        cubetas[fin - 1].agregado.combinar(a);
+    }
+
+    /**
+     * @brief Indica si el nivel superó su máximo de cubetas.
+     */
+    bool excedido() const {
+        return maxCubetas > 0 && fin - inicio > maxCubetas;
+    }
+
+    /**
+     * @brief Retira la cubeta más antigua.
+     * @param[out] c Recibe la cubeta retirada.
+     * @return false si el nivel estaba vacío.
+     */
+    bool retirarPrimera(Cubeta& c) {
+        if (fin == inicio) return false;
+        c = cubetas[inicio++];
+        return true;
+    }
+
+    /**
+     * @brief Agrega las cubetas que se solapan con [t0, t1] en O(log n + cubetas del rango).
+     * @details La precisión en los bordes es la del ancho de la cubeta: una
+     * cubeta que se solapa parcialmente con el rango se cuenta completa.
+     */
+    void agregarRango(MarcaTiempo t0, MarcaTiempo t1, Agregado& a) const {
+        // Primera cubeta que termina después de t0
+        int izq = inicio;
+        int der = fin;
+        while (izq < der) {
+            int medio = (izq + der) / 2;
+            if (cubetas[medio].inicio + anchoMs <= t0) {
+                izq = medio + 1;
+            } else {
+                der = medio;
+            }
+        }
+        for (int i = izq; i < fin && cubetas[i].inicio <= t1; i++) {
+            a.combinar(cubetas[i].agregado);
+        }
+    }
+
+    /**
+     * @brief Agrega todas las cubetas del nivel.
+     */
+    void agregarTodo(Agregado& a) const {
+        for (int i = inicio; i < fin; i++) {
+            a.combinar(cubetas[i].agregado);
+        }
+    }
+
+    /**
+     * @brief Obtiene el número de cubetas retenidas.
+     */
+    int getNumCubetas() const { return fin - inicio; }
+
+    /**
+     * @brief Memoria ocupada por el nivel, en bytes.
+     */
+    long bytesUsados() const {
+        return (long)capacidad * (long)sizeof(Cubeta);
+    }
+};
+
+/**
+ * @class RollupsSensor
+ * @brief Niveles de 1 minuto y 1 hora para las lecturas que salen del historial crudo.
+ * @details Cada lectura compactada va a la cubeta de 1 minuto; cuando el
+ * nivel de minutos supera MAX_MINUTOS, su cubeta más antigua se funde en
+ * el nivel de horas. Cada lectura queda en un único nivel, así que sumar
+ * ambos niveles nunca la cuenta dos veces.
+ */
+class RollupsSensor {
+public:
+    /// @brief Cubetas de 1 minuto retenidas (24 horas).
+    static const int MAX_MINUTOS = 24 * 60;
+
+private:
+    /// @brief Nivel de 1 minuto.
+    NivelRollup minutos;
+    /// @brief Nivel de 1 hora (sin límite: ~8760 cubetas por año).
+    NivelRollup horas;
+
+public:
+    /**
+     * @brief Constructor. Crea ambos niveles vacíos.
+     */
+    RollupsSensor() : minutos(60000, MAX_MINUTOS), horas(3600000, 0) {}
+
+    /**
+     * @brief Incorpora una lectura que sale del historial crudo.
+     * @param t La marca de tiempo de la lectura.
+     * @param valor El valor de la lectura.
+     */
+    void compactar(MarcaTiempo t, double valor) {
+        Agregado a;
+        a.acumular(valor);
+        minutos.acumular(t, a);
+        while (minutos.excedido()) {
+            Cubeta c = Cubeta();
+            if (!minutos.retirarPrimera(c)) break;
+            horas.acumular(c.inicio, c.agregado);
+        }
+    }
+
+    /**
+     * @brief Agrega las cubetas de ambos niveles que se solapan con [t0, t1].
+     */
+    void agregarRango(MarcaTiempo t0, MarcaTiempo t1, Agregado& a) const {
+        horas.agregarRango(t0, t1, a);
+        minutos.agregarRango(t0, t1, a);
+    }
+
+    /**
+     * @brief Agrega todas las lecturas compactadas, en O(cubetas).
+     */
+    void agregarTodo(Agregado& a) const {
+        horas.agregarTodo(a);
+        minutos.agregarTodo(a);
+    }
+
+    /**
+     * @brief Obtiene el número de cubetas de ambos niveles.
+     */
+    int getNumCubetas() const {
+        return minutos.getNumCubetas() + horas.getNumCubetas();
+    }
+
+    /**
+     * @brief Memoria ocupada por ambos niveles, en bytes.
+     */
+    long bytesUsados() const {
+        return minutos.bytesUsados() + horas.bytesUsados();
+    }
+};
+
+#endif
@@ -4,12 +4,37 @@
  */
 
 #include "Sensor.h"
+#include "Exportador.h"
+#include <cctype>  // Para isspace
+#include <cerrno>
+#include <climits> // Para INT_MIN e INT_MAX
+#include <cmath>   // Para std::isfinite
 #include <cstring> // Para strcpy y strcmp
-#include <cstdlib> // Para atof (string a float) y atoi (string a int)
+#include <cstdlib> // Para strtod (string a double) y strtol (string a long)
 #include <iostream>
 
+/**
+ * @brief Nombre legible de un modo de historial (para imprimirInfo).
+ */
+static const char* nombreModo(ModoHistorial modo) {
+    switch (modo) {
+        case HISTORIAL_COMPRIMIDO: return "comprimido";
+        case HISTORIAL_CONCURRENTE: return "concurrente";
+        default: return "lista";
+    }
+}
+
+/**
+ * @brief Indica si después de un número solo queda espacio en blanco.
+ * @param fin Primer carácter que strtod/strtol no consumió.
+ */
+static bool soloEspacios(const char* fin) {
+    while (isspace((unsigned char)*fin)) fin++;
+    return *fin == '\0';
+}
+
 // --- Implementación SensorBase ---
-SensorBase::SensorBase(const char* n) {
+SensorBase::SensorBase(const char* n) : ultimoValor(0), ultimoTiempo(0), hayUltima(false) {
     // Copia segura del nombre (evita desbordamiento)
     strncpy(nombre, n, 49);
     nombre[49] = '\0'; // Asegura terminación nula
@@ -27,12 +52,38 @@ const char* SensorBase::getNombre() const {
 
 
 // --- Implementación SensorTemperatura ---
-SensorTemperatura::SensorTemperatura(const char* n) : SensorBase(n) {}
+SensorTemperatura::SensorTemperatura(const char* n, ModoHistorial modo) : SensorBase(n), historial(modo) {
+    // El índice de mínimos evita los dos recorridos O(n) de procesarLectura()
+    historial.activarIndiceMinimo();
+}
 
 SensorTemperatura::~SensorTemperatura() {
     std::cout << "  [Destructor Sensor " << nombre << "] Liberando Lista Interna <float>..." << std::endl;
-    // El destructor de 'historial' (ListaSensor<float>) se llama automáticamente aquí
-    // y limpiará todos sus nodos gracias a la Regla de los Tres.
+    // El destructor de 'historial' (HistorialSensor<float>) se llama automáticamente aquí
+    // y limpiará todos sus nodos/bloques gracias a la Regla de los Tres.
+}
+
+void SensorTemperatura::agregarLectura(float valor) {
+    agregarLectura(valor, tiempoActual());
+}
+
+void SensorTemperatura::agregarLectura(float valor, MarcaTiempo tiempo) {
+    historial.agregar(valor, tiempo);
+    anotarLectura(valor, tiempo);
+}
+
+Agregado SensorTemperatura::consultarRango(MarcaTiempo t0, MarcaTiempo t1) const {
+    return historial.agregarRango(t0, t1);
+}
+
+void SensorTemperatura::configurarRetencion(int maxCrudas) {
+    historial.configurarRetencion(maxCrudas);
+}
+
+void SensorTemperatura::exportar(Exportador& exportador) const {
+    exportador.comenzarSensor(nombre, SENSOR_TEMPERATURA);
+    historial.recorrer(exportador);
+    exportador.finalizarSensor();
 }
 
 void SensorTemperatura::registrarNuevaLectura(Serial& port) {
@@ -41,56 +92,86 @@ void SensorTemperatura::registrarNuevaLectura(Serial& port) {
 
     while (true) {
         int bytes = port.leerLinea(buffer, 100);
-        if (bytes > 0 && buffer[0] == 'T' && buffer[1] == ':') {
-            // Encontramos una lectura de Temperatura
-            // 'atof' convierte el C-string (desde el 3er char) a float
-            float valor = atof(buffer + 2); 
-            historial.insertarAlFinal(valor);
-            std::cout << "[Log] Insertando Nodo<float> " << valor << " en " << nombre << "." << std::endl;
+        if (bytes > 0 && buffer[0] == 'T' && buffer[1] == ':' && registrarDesdeTexto(buffer + 2)) {
+            // Encontramos una lectura de Temperatura válida (desde el 3er char)
+            std::cout << "[Log] Insertando Nodo<float> " << getUltimoValor() << " en " << nombre << "." << std::endl;
             break;
         }
-        // Si no es 'T:', sigue leyendo hasta encontrarla
+        // Si no es 'T:' o no trae un número, sigue leyendo hasta encontrarla
     }
 }
 
+bool SensorTemperatura::registrarDesdeTexto(const char* texto) {
+    // 'strtod' convierte el C-string y deja en 'fin' dónde dejó de leer
+    char* fin;
+    float valor = (float)strtod(texto, &fin);
+    if (fin == texto || !soloEspacios(fin) || !std::isfinite(valor)) return false;
+    agregarLectura(valor);
+    return true;
+}
+
 void SensorTemperatura::procesarLectura() {
-    Nodo<float>* actual = historial.getCabeza();
-    if (actual == nullptr) {
-        std::cout << "[" << nombre << "] (Temperatura): No hay lecturas para procesar." << std::endl;
-        return;
+    float minVal;
+
+    // Lógica: Encontrar y eliminar la lectura más baja (O(log n) con el índice)
+    resultado = ResultadoProceso();
+    if (historial.extraerMinimo(minVal)) {
+        // Promedio restante de todo el historial, como en SensorPresion:
+        // suma acumulada de las crudas + rollups de las compactadas
+        Agregado total = historial.agregarTotal();
+        resultado.hayDatos = true;
+        resultado.lecturas = total.cantidad;
+        resultado.valor = minVal;
+        resultado.promedio = (float)total.promedio();
     }
+    imprimirResultado();
+}
 
-    // Lógica: Encontrar y eliminar la lectura más baja
-    float minVal = actual->dato;
-    float suma = 0;
-    int n = historial.getTamano();
-
-    while (actual != nullptr) {
-        if (actual->dato < minVal) {
-            minVal = actual->dato;
-        }
-        suma += actual->dato;
-        actual = actual->siguiente;
+void SensorTemperatura::imprimirResultado() const {
+    if (!resultado.hayDatos) {
+        std::cout << "[" << nombre << "] (Temperatura): No hay lecturas para procesar." << std::endl;
+        return;
     }
-
-    historial.eliminarValor(minVal);
-    float promedioRestante = (n > 1) ? (suma - minVal) / (n - 1) : 0;
-
-    std::cout << "[" << nombre << "] (Temperatura): Lectura mas baja (" << minVal << ") eliminada. Promedio restante: " << promedioRestante << "." << std::endl;
+    std::cout << "[" << nombre << "] (Temperatura): Lectura mas baja (" << resultado.valor << ") eliminada. Promedio restante: " << resultado.promedio << "." << std::endl;
 }
 
 void SensorTemperatura::imprimirInfo() const {
     // (Este método no se usa en el ejemplo, pero es requerido)
-    std::cout << "Sensor [TEMP] " << nombre << std::endl;
+    std::cout << "Sensor [TEMP] " << nombre
+              << " (" << nombreModo(historial.getModo()) << ", "
+              << historial.getTamano() << " lecturas, " << historial.bytesUsados() << " bytes)" << std::endl;
 }
 
 
 // --- Implementación SensorPresion ---
-SensorPresion::SensorPresion(const char* n) : SensorBase(n) {}
+SensorPresion::SensorPresion(const char* n, ModoHistorial modo) : SensorBase(n), historial(modo) {}
 
 SensorPresion::~SensorPresion() {
     std::cout << "  [Destructor Sensor " << nombre << "] Liberando Lista Interna <int>..." << std::endl;
-    // El destructor de 'historial' (ListaSensor<int>) se llama automáticamente.
+    // El destructor de 'historial' (HistorialSensor<int>) se llama automáticamente.
+}
+
+void SensorPresion::agregarLectura(int valor) {
+    agregarLectura(valor, tiempoActual());
+}
+
+void SensorPresion::agregarLectura(int valor, MarcaTiempo tiempo) {
+    historial.agregar(valor, tiempo);
+    anotarLectura((float)valor, tiempo);
+}
+
+Agregado SensorPresion::consultarRango(MarcaTiempo t0, MarcaTiempo t1) const {
+    return historial.agregarRango(t0, t1);
+}
+
+void SensorPresion::configurarRetencion(int maxCrudas) {
+    historial.configurarRetencion(maxCrudas);
+}
+
+void SensorPresion::exportar(Exportador& exportador) const {
+    exportador.comenzarSensor(nombre, SENSOR_PRESION);
+    historial.recorrer(exportador);
+    exportador.finalizarSensor();
 }
 
 void SensorPresion::registrarNuevaLectura(Serial& port) {
@@ -99,39 +180,49 @@ void SensorPresion::registrarNuevaLectura(Serial& port) {
 
     while (true) {
         int bytes = port.leerLinea(buffer, 100);
-        if (bytes > 0 && buffer[0] == 'P' && buffer[1] == ':') {
-            // Encontramos una lectura de Presión
-            // 'atoi' convierte el C-string (desde el 3er char) a int
-            int valor = atoi(buffer + 2);
-            historial.insertarAlFinal(valor);
-            std::cout << "[Log] Insertando Nodo<int> " << valor << " en " << nombre << "." << std::endl;
+        if (bytes > 0 && buffer[0] == 'P' && buffer[1] == ':' && registrarDesdeTexto(buffer + 2)) {
+            // Encontramos una lectura de Presión válida (desde el 3er char)
+            std::cout << "[Log] Insertando Nodo<int> " << (int)getUltimoValor() << " en " << nombre << "." << std::endl;
             break;
         }
-        // Si no es 'P:', sigue leyendo
+        // Si no es 'P:' o no trae un entero, sigue leyendo
     }
 }
 
+bool SensorPresion::registrarDesdeTexto(const char* texto) {
+    // 'strtol' convierte el C-string y deja en 'fin' dónde dejó de leer
+    char* fin;
+    errno = 0;
+    long valor = strtol(texto, &fin, 10);
+    if (fin == texto || !soloEspacios(fin) || errno != 0 || valor < INT_MIN || valor > INT_MAX) return false;
+    agregarLectura((int)valor);
+    return true;
+}
+
 void SensorPresion::procesarLectura() {
-    Nodo<int>* actual = historial.getCabeza();
-    int n = historial.getTamano();
+    // Lógica: Calcular el promedio (suma acumulada + rollups, sin recorrer lecturas)
+    Agregado total = historial.agregarTotal();
+
+    resultado = ResultadoProceso();
+    resultado.lecturas = total.cantidad;
+    if (total.cantidad > 0) {
+        resultado.hayDatos = true;
+        resultado.promedio = (float)total.promedio();
+    }
+    imprimirResultado();
+}
 
-    if (n == 0) {
+void SensorPresion::imprimirResultado() const {
+    if (!resultado.hayDatos) {
         std::cout << "[" << nombre << "] (Presion): No hay lecturas para procesar." << std::endl;
         return;
     }
-
-    // Lógica: Calcular el promedio
-    float suma = 0;
-    while (actual != nullptr) {
-        suma += actual->dato;
-        actual = actual->siguiente;
-    }
-
-    float promedio = suma / n;
-    std::cout << "[" << nombre << "] (Presion): Promedio de " << n << " lecturas: " << promedio << "." << std::endl;
+    std::cout << "[" << nombre << "] (Presion): Promedio de " << resultado.lecturas << " lecturas: " << resultado.promedio << "." << std::endl;
 }
 
 void SensorPresion::imprimirInfo() const {
     // (Este método no se usa en el ejemplo, pero es requerido)
-    std::cout << "Sensor [PRESION] " << nombre << std::endl;
+    std::cout << "Sensor [PRESION] " << nombre
+              << " (" << nombreModo(historial.getModo()) << ", "
+              << historial.getTamano() << " lecturas, " << historial.bytesUsados() << " bytes)" << std::endl;
 }
\ No newline at end of file
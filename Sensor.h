@@ -7,10 +7,48 @@
 #ifndef SENSOR_H
 #define SENSOR_H
 
-#include "ListaSensor.h"
+#include "Historial.h"
 #include "Serial.h"
 #include <iostream>
 
+class Exportador; // Definido en Exportador.h
+
+/**
+ * @enum TipoSensor
+ * @brief Tipo concreto de un sensor (para reglas por tipo).
+ */
+enum TipoSensor {
+    /// @brief SensorTemperatura (lecturas float).
+    SENSOR_TEMPERATURA,
+    /// @brief SensorPresion (lecturas int).
+    SENSOR_PRESION,
+    /// @brief Número de tipos (no es un tipo válido).
+    NUM_TIPOS_SENSOR
+};
+
+/**
+ * @struct ResultadoProceso
+ * @brief Último resultado calculado por procesarLectura(), guardado en cache.
+ * @details Cada tipo de sensor usa los campos que le corresponden:
+ * temperatura guarda la lectura eliminada en `valor` y el promedio restante;
+ * presión guarda el promedio y la cantidad de lecturas.
+ */
+struct ResultadoProceso {
+    /// @brief false si no había lecturas al procesar.
+    bool hayDatos;
+    /// @brief Lecturas consideradas.
+    int lecturas;
+    /// @brief Valor destacado del procesamiento (ej. la lectura más baja).
+    float valor;
+    /// @brief Promedio calculado.
+    float promedio;
+
+    /**
+     * @brief Constructor. Resultado vacío.
+     */
+    ResultadoProceso() : hayDatos(false), lecturas(0), valor(0), promedio(0) {}
+};
+
 /**
  * @class SensorBase
  * @brief Clase Base Abstracta para todos los sensores del sistema.
@@ -21,6 +59,25 @@ class SensorBase {
 protected:
     /// @brief Identificador del sensor (ej. "T-001", "P-105").
     char nombre[50];
+    /// @brief Resultado del último procesarLectura().
+    ResultadoProceso resultado;
+    /// @brief Valor de la última lectura ingresada.
+    float ultimoValor;
+    /// @brief Marca de tiempo de la última lectura ingresada.
+    MarcaTiempo ultimoTiempo;
+    /// @brief false hasta la primera lectura.
+    bool hayUltima;
+
+    /**
+     * @brief Anota una lectura recién ingresada (la usan las alertas).
+     * @details Qué sensores hay que reprocesar lo lleva Sistema (ver
+     * Sistema::marcarPendiente), no el sensor.
+     */
+    void anotarLectura(float valor, MarcaTiempo tiempo) {
+        ultimoValor = valor;
+        ultimoTiempo = tiempo;
+        hayUltima = true;
+    }
 
 public:
     /**
@@ -43,9 +100,17 @@ public:
     /**
      * @brief Método virtual puro para procesar las lecturas almacenadas.
      * @details Cada clase derivada debe implementar su propia lógica
-     * (ej. calcular promedio, encontrar mínimo, etc.).
+     * (ej. calcular promedio, encontrar mínimo, etc.) y guardar el resultado
+     * en `resultado`.
      */
     virtual void procesarLectura() = 0;
+
+    /**
+     * @brief Método virtual puro para imprimir el resultado en cache.
+     * @details Imprime el mismo mensaje que el último procesarLectura(), sin
+     * volver a calcular.
+     */
+    virtual void imprimirResultado() const = 0;
     
     /**
      * @brief Método virtual puro para imprimir información del sensor.
@@ -61,42 +126,123 @@ public:
      */
     virtual void registrarNuevaLectura(Serial& port) = 0;
 
+    /**
+     * @brief Método virtual puro para registrar una lectura ya recibida como texto.
+     * @details Convierte el texto al tipo de dato del sensor y lo agrega al
+     * historial, sin esperar al puerto ni imprimir (para el modo demonio).
+     * El texto debe ser un número completo del tipo del sensor (se admiten
+     * espacios al final); si no, no se registra nada: una línea con ruido
+     * (ej. "T:abc" o "P:") no debe entrar como una lectura 0.
+     * @param texto El valor, sin el prefijo (ej. "23.5" de "T:23.5").
+     * @return false si el texto no es un valor válido.
+     */
+    virtual bool registrarDesdeTexto(const char* texto) = 0;
+
+    /**
+     * @brief Método virtual puro para agregar las lecturas de un rango de tiempo.
+     * @details Cada implementación usa la búsqueda binaria de su historial,
+     * sin recorrer todas las lecturas.
+     * @param t0 Inicio del rango (inclusive).
+     * @param t1 Fin del rango (inclusive).
+     * @return Cantidad, suma, mínimo y máximo de las lecturas del rango.
+     */
+    virtual Agregado consultarRango(MarcaTiempo t0, MarcaTiempo t1) const = 0;
+
+    /**
+     * @brief Método virtual puro para fijar cuántas lecturas crudas se conservan.
+     * @details Las más antiguas se compactan en rollups de 1 minuto y 1 hora.
+     * @param maxCrudas Lecturas crudas a conservar (0 = sin límite).
+     */
+    virtual void configurarRetencion(int maxCrudas) = 0;
+
+    /**
+     * @brief Método virtual puro que informa el tipo concreto del sensor.
+     */
+    virtual TipoSensor getTipo() const = 0;
+
+    /**
+     * @brief Método virtual puro para exportar las lecturas crudas del sensor.
+     * @details Recorre el historial en streaming y entrega cada lectura al
+     * exportador, que las escribe por lotes.
+     * @param exportador El exportador (columnar o CSV).
+     */
+    virtual void exportar(Exportador& exportador) const = 0;
+
     /**
      * @brief Obtiene el nombre (ID) del sensor.
      * @return Un puntero constante al C-string del nombre.
      */
     const char* getNombre() const;
+
+    /**
+     * @brief Indica si el sensor recibió al menos una lectura.
+     */
+    bool tieneLecturas() const { return hayUltima; }
+
+    /**
+     * @brief Obtiene el valor de la última lectura ingresada.
+     */
+    float getUltimoValor() const { return ultimoValor; }
+
+    /**
+     * @brief Obtiene la marca de tiempo de la última lectura ingresada.
+     */
+    MarcaTiempo getUltimoTiempo() const { return ultimoTiempo; }
 };
 
 
 /**
  * @class SensorTemperatura
  * @brief Clase derivada que maneja lecturas de temperatura (float).
- * @details Contiene una ListaSensor interna para almacenar valores float.
+ * @details Contiene un HistorialSensor interno para almacenar valores float.
+ * En modo lista se activa el índice de mínimos para que procesarLectura()
+ * extraiga la lectura más baja en O(log n).
  */
 class SensorTemperatura : public SensorBase {
 private:
-    /// @brief Lista enlazada interna para el historial de lecturas (float).
-    ListaSensor<float> historial;
+    /// @brief Historial interno de lecturas (float).
+    HistorialSensor<float> historial;
 
 public:
     /**
      * @brief Constructor de SensorTemperatura.
      * @param n El nombre (ID) para este sensor.
+     * @param modo Estructura del historial (lista por defecto, comprimido o concurrente).
      */
-    SensorTemperatura(const char* n);
+    SensorTemperatura(const char* n, ModoHistorial modo = HISTORIAL_LISTA);
     
     /**
      * @brief Destructor de SensorTemperatura.
-     * @details Imprime un log y libera automáticamente su 'historial' (ListaSensor<float>).
+     * @details Imprime un log y libera automáticamente su 'historial' (HistorialSensor<float>).
      */
     ~SensorTemperatura();
 
+    /**
+     * @brief Agrega una lectura ya convertida al historial, con la hora actual.
+     * @param valor La temperatura leída.
+     */
+    void agregarLectura(float valor);
+
+    /**
+     * @brief Agrega una lectura ya convertida al historial.
+     * @param valor La temperatura leída.
+     * @param tiempo Su marca de tiempo (no menor que la de la lectura anterior).
+     */
+    void agregarLectura(float valor, MarcaTiempo tiempo);
+
     /**
      * @brief Implementación del procesamiento para SensorTemperatura.
-     * @details Calcula y elimina el valor más bajo de su lista interna.
+     * @details Calcula y elimina el valor más bajo de su historial interno
+     * (O(log n) en modo lista, O(bloques) en modo comprimido) y reporta el
+     * promedio restante de todo el historial, como SensorPresion: las crudas
+     * a partir de la suma acumulada y las compactadas a partir de los rollups.
      */
     void procesarLectura() override;
+
+    /**
+     * @brief Imprime la última lectura eliminada y el promedio restante en cache.
+     */
+    void imprimirResultado() const override;
     
     /**
      * @brief Implementación de la impresión de info para SensorTemperatura.
@@ -109,37 +255,83 @@ public:
      * @param port Referencia al objeto Serial.
      */
     void registrarNuevaLectura(Serial& port) override;
+
+    /**
+     * @brief Registra una lectura float recibida como texto.
+     * @return false si no es un número finito.
+     */
+    bool registrarDesdeTexto(const char* texto) override;
+
+    /**
+     * @brief Implementación de la consulta por rango para SensorTemperatura.
+     */
+    Agregado consultarRango(MarcaTiempo t0, MarcaTiempo t1) const override;
+
+    /**
+     * @brief Implementación de la retención para SensorTemperatura.
+     */
+    void configurarRetencion(int maxCrudas) override;
+
+    /**
+     * @brief Devuelve SENSOR_TEMPERATURA.
+     */
+    TipoSensor getTipo() const override { return SENSOR_TEMPERATURA; }
+
+    /**
+     * @brief Implementación de la exportación para SensorTemperatura.
+     */
+    void exportar(Exportador& exportador) const override;
 };
 
 
 /**
  * @class SensorPresion
  * @brief Clase derivada que maneja lecturas de presión (int).
- * @details Contiene una ListaSensor interna para almacenar valores int.
+ * @details Contiene un HistorialSensor interno para almacenar valores int.
  */
 class SensorPresion : public SensorBase {
 private:
-    /// @brief Lista enlazada interna para el historial de lecturas (int).
-    ListaSensor<int> historial;
+    /// @brief Historial interno de lecturas (int).
+    HistorialSensor<int> historial;
 
 public:
     /**
      * @brief Constructor de SensorPresion.
      * @param n El nombre (ID) para este sensor.
+     * @param modo Estructura del historial (lista por defecto, comprimido o concurrente).
      */
-    SensorPresion(const char* n);
+    SensorPresion(const char* n, ModoHistorial modo = HISTORIAL_LISTA);
     
     /**
      * @brief Destructor de SensorPresion.
-     * @details Imprime un log y libera automáticamente su 'historial' (ListaSensor<int>).
+     * @details Imprime un log y libera automáticamente su 'historial' (HistorialSensor<int>).
      */
     ~SensorPresion();
 
+    /**
+     * @brief Agrega una lectura ya convertida al historial, con la hora actual.
+     * @param valor La presión leída.
+     */
+    void agregarLectura(int valor);
+
+    /**
+     * @brief Agrega una lectura ya convertida al historial.
+     * @param valor La presión leída.
+     * @param tiempo Su marca de tiempo (no menor que la de la lectura anterior).
+     */
+    void agregarLectura(int valor, MarcaTiempo tiempo);
+
     /**
      * @brief Implementación del procesamiento para SensorPresion.
-     * @details Calcula el promedio de todas sus lecturas.
+     * @details Calcula el promedio de todas sus lecturas: las crudas a partir
+     * de la suma acumulada y las compactadas a partir de los rollups.
      */
     void procesarLectura() override;
+
+    /**
+     * @brief Imprime el promedio en cache.
+     */
+    void imprimirResultado() const override;
     
     /**
      * @brief Implementación de la impresión de info para SensorPresion.
@@ -152,6 +344,32 @@ public:
      * @param port Referencia al objeto Serial.
      */
     void registrarNuevaLectura(Serial& port) override;
+
+    /**
+     * @brief Registra una lectura int recibida como texto.
+     * @return false si no es un entero dentro del rango de int.
+     */
+    bool registrarDesdeTexto(const char* texto) override;
+
+    /**
+     * @brief Implementación de la consulta por rango para SensorPresion.
+     */
+    Agregado consultarRango(MarcaTiempo t0, MarcaTiempo t1) const override;
+
+    /**
+     * @brief Implementación de la retención para SensorPresion.
+     */
+    void configurarRetencion(int maxCrudas) override;
+
+    /**
+     * @brief Devuelve SENSOR_PRESION.
+     */
+    TipoSensor getTipo() const override { return SENSOR_PRESION; }
+
+    /**
+     * @brief Implementación de la exportación para SensorPresion.
+     */
+    void exportar(Exportador& exportador) const override;
 };
 
 #endif
\ No newline at end of file
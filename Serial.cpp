@@ -9,7 +9,7 @@
 #include <iostream>
 #include <cstring> // Para memset
 
-Serial::Serial() : fd(-1) {}
+Serial::Serial() : fd(-1), inicioLectura(0), finLectura(0) {}
 
 Serial::~Serial() {
     if (fd != -1) {
@@ -18,11 +18,38 @@ Serial::~Serial() {
 }
 
 void Serial::cerrar() {
-    close(fd);
+    if (fd != -1) close(fd);
     fd = -1;
+    inicioLectura = 0;
+    finLectura = 0;
+}
+
+bool Serial::velocidadTermios(int baudrate, speed_t& speed) {
+    switch (baudrate) {
+        case 9600: speed = B9600; return true;
+        case 19200: speed = B19200; return true;
+        case 38400: speed = B38400; return true;
+        case 57600: speed = B57600; return true;
+        case 115200: speed = B115200; return true;
+        case 230400: speed = B230400; return true;
+#ifdef B460800
+        case 460800: speed = B460800; return true;
+#endif
+#ifdef B921600
+        case 921600: speed = B921600; return true;
+#endif
+        default: return false;
+    }
 }
 
 bool Serial::abrir(const char* puerto, int baudrate) {
+    // Validar la velocidad antes de tocar el puerto
+    speed_t speed;
+    if (!velocidadTermios(baudrate, speed)) {
+        std::cerr << "Error [Serial] velocidad no soportada: " << baudrate << std::endl;
+        return false;
+    }
+
     // Abrir el puerto
     // O_RDWR = Leer y Escribir
     // O_NOCTTY = No convertirlo en la terminal de control del proceso
@@ -35,6 +62,7 @@ bool Serial::abrir(const char* puerto, int baudrate) {
     // Obtener la configuración actual del puerto
     if (tcgetattr(fd, &tty) != 0) {
         std::cerr << "Error [Serial] al obtener atributos" << std::endl;
+        cerrar();
         return false;
     }
 
@@ -43,12 +71,6 @@ bool Serial::abrir(const char* puerto, int baudrate) {
     memset(&tty, 0, sizeof(tty));
 
     // Configuración de Baudrate (velocidad)
-    speed_t speed;
-    switch (baudrate) {
-        case 9600: speed = B9600; break;
-        case 115200: speed = B115200; break;
-        default: speed = B9600;
-    }
     cfsetospeed(&tty, speed);
     cfsetispeed(&tty, speed);
 
@@ -72,6 +94,7 @@ bool Serial::abrir(const char* puerto, int baudrate) {
     // Aplicar la configuración
     if (tcsetattr(fd, TCSANOW, &tty) != 0) {
         std::cerr << "Error [Serial] al aplicar atributos" << std::endl;
+        cerrar();
         return false;
     }
 
@@ -79,20 +102,57 @@ bool Serial::abrir(const char* puerto, int baudrate) {
 }
 
 int Serial::leerLinea(char* buffer, int tamBuffer) {
-    char c = '\0';
-    int i = 0;
-    while (i < tamBuffer - 1) {
-        int n = read(fd, &c, 1); // Lee 1 byte
-        if (n > 0) {
-            if (c == '\n' || c == '\r') {
-                if (i > 0) break; // Termina si ya tenemos datos
-            } else {
-                buffer[i] = c;
-                i++;
-            }
+    while (true) {
+        int n = extraerLinea(buffer, tamBuffer);
+        if (n > 0) return n;
+        rellenar(); // Si es un timeout o error, reintentamos
+    }
+}
+
+int Serial::rellenar() {
+    // Corre los bytes pendientes al inicio para dejar lugar al final
+    if (inicioLectura > 0) {
+        memmove(bufferLectura, bufferLectura + inicioLectura, finLectura - inicioLectura);
+        finLectura -= inicioLectura;
+        inicioLectura = 0;
+    }
+    if (finLectura == TAM_BUFFER_LECTURA) return 0;
+
+    int n = read(fd, bufferLectura + finLectura, TAM_BUFFER_LECTURA - finLectura);
+    if (n > 0) finLectura += n;
+    return n;
+}
+
+int Serial::extraerLinea(char* buffer, int tamBuffer) {
+    while (inicioLectura < finLectura) {
+        // Omite los separadores de una línea vacía (o el '\r' de "\r\n")
+        char c = bufferLectura[inicioLectura];
+        if (c == '\n' || c == '\r') {
+            inicioLectura++;
+            continue;
+        }
+
+        const char* inicio = bufferLectura + inicioLectura;
+        const char* fin = static_cast<const char*>(memchr(inicio, '\n', finLectura - inicioLectura));
+        const char* finCr = static_cast<const char*>(memchr(inicio, '\r', finLectura - inicioLectura));
+        if (finCr != nullptr && (fin == nullptr || finCr < fin)) fin = finCr;
+
+        int largo;
+        if (fin != nullptr) {
+            largo = (int)(fin - inicio);
+        } else if (inicioLectura == 0 && finLectura == TAM_BUFFER_LECTURA) {
+            largo = finLectura; // Línea más larga que todo el buffer: se entrega tal cual
+        } else {
+            return 0; // Línea incompleta: esperar más datos
         }
-        // Si n <= 0, es un timeout o error, reintentamos
+
+        if (largo > tamBuffer - 1) largo = tamBuffer - 1;
+        memcpy(buffer, inicio, largo);
+        buffer[largo] = '\0';
+        inicioLectura += largo;
+        return largo;
     }
-    buffer[i] = '\0'; // Terminar el C-string
-    return i;
-}
\ No newline at end of file
+    inicioLectura = 0;
+    finLectura = 0;
+    return 0;
+}
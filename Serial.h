@@ -17,11 +17,29 @@
  * para configurar y leer desde un puerto serial.
  */
 class Serial {
+public:
+    /// @brief Tamaño del buffer interno de lectura.
+    static const int TAM_BUFFER_LECTURA = 4096;
+
 private:
     /// @brief File Descriptor (identificador de archivo) para el puerto serial.
     int fd;
     /// @brief Estructura termios que almacena la configuración del puerto.
     struct termios tty;
+    /// @brief Bytes recibidos y aún no entregados como líneas.
+    char bufferLectura[TAM_BUFFER_LECTURA];
+    /// @brief Primer byte pendiente de `bufferLectura`.
+    int inicioLectura;
+    /// @brief Una posición después del último byte pendiente.
+    int finLectura;
+
+    /**
+     * @brief Convierte un baudrate numérico a su constante termios.
+     * @param baudrate La velocidad (ej. 115200).
+     * @param[out] speed La constante (ej. B115200).
+     * @return false si la velocidad no está soportada.
+     */
+    static bool velocidadTermios(int baudrate, speed_t& speed);
 
 public:
     /**
@@ -39,8 +57,11 @@ public:
     /**
      * @brief Abre y configura el puerto serial.
      * @param puerto La ruta del dispositivo (ej. "/dev/ttyACM0").
-     * @param baudrate La velocidad de comunicación (ej. 9600).
-     * @return true si la apertura y configuración fueron exitosas, false en caso contrario.
+     * @param baudrate La velocidad de comunicación: 9600, 19200, 38400,
+     * 57600, 115200, 230400, 460800 o 921600 (las dos últimas si el sistema
+     * las define).
+     * @return true si la apertura y configuración fueron exitosas, false en
+     * caso contrario (incluida una velocidad no soportada).
      */
     bool abrir(const char* puerto, int baudrate);
     
@@ -51,13 +72,37 @@ public:
 
     /**
      * @brief Lee una línea completa (hasta '\n') del puerto serial.
-     * @details Lee byte por byte hasta encontrar un salto de línea o llenar el buffer.
-     * Es una lectura bloqueante con timeout.
+     * @details Es una lectura bloqueante: espera hasta tener una línea no
+     * vacía. Lee del puerto por bloques al buffer interno (no byte por
+     * byte) y entrega las líneas desde ahí.
      * @param buffer Puntero al buffer de char donde se guardará la línea.
      * @param tamBuffer El tamaño máximo del buffer.
      * @return El número de bytes leídos (excluyendo el '\0').
      */
     int leerLinea(char* buffer, int tamBuffer);
+
+    /**
+     * @brief Lee del puerto todos los bytes disponibles al buffer interno.
+     * @details Hace una sola llamada a read(); pensado para llamarse cuando
+     * poll() indica que el puerto tiene datos.
+     * @return Bytes leídos, 0 si no había espacio o datos, -1 si hubo error.
+     */
+    int rellenar();
+
+    /**
+     * @brief Extrae una línea completa del buffer interno, sin bloquear.
+     * @details Omite las líneas vacías. Una línea más larga que `tamBuffer`
+     * se entrega en partes.
+     * @param buffer Puntero al buffer de char donde se guardará la línea.
+     * @param tamBuffer El tamaño máximo del buffer.
+     * @return El número de bytes de la línea, o 0 si todavía no hay una completa.
+     */
+    int extraerLinea(char* buffer, int tamBuffer);
+
+    /**
+     * @brief Obtiene el file descriptor del puerto (para poll()).
+     */
+    int getFd() const { return fd; }
 };
 
 #endif
\ No newline at end of file
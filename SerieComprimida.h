@@ -0,0 +1,592 @@
+/**
+ * @file SerieComprimida.h
+ * @brief Define la clase genérica SerieComprimida y sus bloques de solo-anexar.
+ */
+#ifndef SERIECOMPRIMIDA_H
+#define SERIECOMPRIMIDA_H
+
+#include "Codificadores.h"
+#include "Tiempo.h"
+
+/**
+ * @struct FlujoBits
+ * @brief Buffer de bits que crece por duplicación; una columna de un bloque.
+ */
+struct FlujoBits {
+    /// @brief Bytes del flujo (en cero más allá de `bits`).
+    unsigned char* datos;
+    /// @brief Bytes reservados para `datos`.
+    long capacidadBytes;
+    /// @brief Bits escritos en `datos`.
+    long bits;
+
+    /**
+     * @brief Constructor. Reserva un buffer inicial pequeño.
+     */
+    FlujoBits() : capacidadBytes(32), bits(0) {
+        datos = new unsigned char[capacidadBytes]();
+    }
+
+    /**
+     * @brief Destructor. Libera el buffer.
+     */
+    ~FlujoBits() {
+        delete[] datos;
+    }
+
+    /**
+     * @brief Copia el contenido de otro flujo (reemplaza el actual).
+     */
+    void copiarDesde(const FlujoBits& otro) {
+        delete[] datos;
+        capacidadBytes = otro.capacidadBytes;
+        datos = new unsigned char[capacidadBytes];
+        memcpy(datos, otro.datos, capacidadBytes);
+        bits = otro.bits;
+    }
+
+    /**
+     * @brief Garantiza espacio para `bitsExtra` bits más, duplicando el buffer.
+     */
+    void reservar(long bitsExtra) {
+        long necesarios = (bits + bitsExtra + 7) / 8;
+        if (necesarios <= capacidadBytes) return;
+        long nuevaCapacidad = capacidadBytes * 2;
+        while (nuevaCapacidad < necesarios) nuevaCapacidad *= 2;
+        unsigned char* nuevos = new unsigned char[nuevaCapacidad]();
+        memcpy(nuevos, datos, capacidadBytes);
+        delete[] datos;
+        datos = nuevos;
+        capacidadBytes = nuevaCapacidad;
+    }
+
+    /**
+     * @brief Ajusta el buffer a los bytes realmente usados (al cerrar el bloque).
+     */
+    void ajustar() {
+        long usados = (bits + 7) / 8;
+        if (usados == 0 || usados == capacidadBytes) return;
+        unsigned char* nuevos = new unsigned char[usados];
+        memcpy(nuevos, datos, usados);
+        delete[] datos;
+        datos = nuevos;
+        capacidadBytes = usados;
+    }
+
+private:
+    // No copiable implícitamente: usar copiarDesde().
+    FlujoBits(const FlujoBits&);
+    FlujoBits& operator=(const FlujoBits&);
+};
+
+/**
+ * @struct BloqueComprimido
+ * @brief Bloque de solo-anexar con muestras codificadas y su resumen.
+ * @details Las muestras se guardan en dos columnas independientes: los
+ * valores y sus marcas de tiempo. Así los recorridos que solo necesitan
+ * valores no decodifican tiempos. Además guarda el rango de tiempo del
+ * bloque y el resumen de sus muestras vivas (mínimo, máximo, suma), de modo
+ * que los agregados se resuelven en O(bloques). Las muestras eliminadas se
+ * marcan en un mapa de bits que solo se reserva si hay alguna eliminación.
+ * @tparam T El tipo de dato de las muestras (float o int).
+ */
+template <typename T>
+struct BloqueComprimido {
+    /// @brief Máximo de muestras por bloque (acota el costo de recalcular el resumen).
+    static const int MAX_MUESTRAS = 1024;
+
+    /// @brief Columna de valores (Codificador<T>).
+    FlujoBits valores;
+    /// @brief Columna de marcas de tiempo (CodificadorTiempos).
+    FlujoBits tiempos;
+    /// @brief Marca de tiempo de la primera muestra del bloque.
+    MarcaTiempo tInicio;
+    /// @brief Marca de tiempo de la última muestra del bloque.
+    MarcaTiempo tFin;
+    /// @brief Muestras codificadas en el bloque (incluye eliminadas).
+    int cantidad;
+    /// @brief Muestras no eliminadas.
+    int vivas;
+    /// @brief Mapa de bits de muestras eliminadas (nullptr si no hay ninguna).
+    unsigned char* eliminados;
+    /// @brief Mínimo de las muestras vivas.
+    T minimo;
+    /// @brief Máximo de las muestras vivas.
+    T maximo;
+    /// @brief Suma de las muestras vivas.
+    double suma;
+
+    /**
+     * @brief Constructor. Crea un bloque vacío.
+     */
+    BloqueComprimido() : tInicio(0), tFin(0), cantidad(0), vivas(0),
+                         eliminados(nullptr), minimo(0), maximo(0), suma(0) {}
+
+    /**
+     * @brief Destructor. Libera el mapa de eliminados (las columnas se liberan solas).
+     */
+    ~BloqueComprimido() {
+        delete[] eliminados;
+    }
+
+    /**
+     * @brief Crea una copia profunda del bloque.
+     */
+    BloqueComprimido<T>* clonar() const {
+        BloqueComprimido<T>* copia = new BloqueComprimido<T>();
+        copia->valores.copiarDesde(valores);
+        copia->tiempos.copiarDesde(tiempos);
+        copia->tInicio = tInicio;
+        copia->tFin = tFin;
+        copia->cantidad = cantidad;
+        copia->vivas = vivas;
+        if (eliminados != nullptr) {
+            copia->eliminados = new unsigned char[MAX_MUESTRAS / 8];
+            memcpy(copia->eliminados, eliminados, MAX_MUESTRAS / 8);
+        }
+        copia->minimo = minimo;
+        copia->maximo = maximo;
+        copia->suma = suma;
+        return copia;
+    }
+
+    /**
+     * @brief Ajusta ambas columnas a los bytes usados (al cerrar el bloque).
+     */
+    void ajustar() {
+        valores.ajustar();
+        tiempos.ajustar();
+    }
+
+    /**
+     * @brief Indica si la muestra `i` está eliminada.
+     */
+    bool estaEliminada(int i) const {
+        return eliminados != nullptr && (eliminados[i >> 3] & (1 << (i & 7))) != 0;
+    }
+
+    /**
+     * @brief Marca la muestra `i` como eliminada.
+     */
+    void marcarEliminada(int i) {
+        if (eliminados == nullptr) {
+            eliminados = new unsigned char[MAX_MUESTRAS / 8]();
+        }
+        eliminados[i >> 3] |= (unsigned char)(1 << (i & 7));
+        vivas--;
+    }
+
+    /**
+     * @brief Incorpora una muestra nueva al resumen.
+     */
+    void acumular(T valor) {
+        if (vivas == 0) {
+            minimo = valor;
+            maximo = valor;
+        } else {
+            if (valor < minimo) minimo = valor;
+            if (maximo < valor) maximo = valor;
+        }
+        suma += valor;
+        vivas++;
+    }
+
+    /**
+     * @brief Recalcula el resumen decodificando el bloque completo.
+     * @details Se usa tras una eliminación; cuesta O(MAX_MUESTRAS).
+     */
+    void recalcularResumen() {
+        typename Codificador<T>::Estado estado;
+        Codificador<T>::iniciar(estado);
+        LectorBits lector(valores.datos);
+        int total = cantidad;
+        vivas = 0;
+        suma = 0;
+        for (int i = 0; i < total; i++) {
+            T valor = Codificador<T>::decodificar(estado, lector);
+            if (!estaEliminada(i)) acumular(valor);
+        }
+    }
+
+    /**
+     * @brief Agrega el resumen del bloque a un Agregado.
+     */
+    void combinarResumen(Agregado& a) const {
+        Agregado resumen;
+        resumen.cantidad = vivas;
+        resumen.suma = suma;
+        resumen.minimo = minimo;
+        resumen.maximo = maximo;
+        a.combinar(resumen);
+    }
+
+    /**
+     * @brief Memoria ocupada por el bloque, en bytes.
+     */
+    long bytesUsados() const {
+        return (long)sizeof(*this) + valores.capacidadBytes + tiempos.capacidadBytes
+             + (eliminados != nullptr ? MAX_MUESTRAS / 8 : 0);
+    }
+
+private:
+    // No copiable implícitamente: usar clonar().
+    BloqueComprimido(const BloqueComprimido<T>&);
+    BloqueComprimido<T>& operator=(const BloqueComprimido<T>&);
+};
+
+template <typename T> class LectorSerie;
+
+/**
+ * @class SerieComprimida
+ * @brief Historial comprimido de solo-anexar, organizado en bloques.
+ * @details Alternativa de bajo consumo de memoria a ListaSensor: en lugar de
+ * un Nodo por lectura, las muestras se codifican con Codificador<T>
+ * (decimales escalados o Gorilla para float, delta-de-delta para int) y
+ * sus marcas de tiempo con CodificadorTiempos, en columnas separadas. Los
+ * recorridos decodifican en streaming con LectorSerie, sin materializar
+ * la serie. Cumple con la Regla de los Tres.
+ * @tparam T El tipo de dato de las muestras (float o int).
+ */
+template <typename T>
+class SerieComprimida {
+private:
+    /// @brief Arreglo dinámico de punteros a bloques, en orden de llegada.
+    BloqueComprimido<T>** bloques;
+    /// @brief Número de bloques en uso.
+    int numBloques;
+    /// @brief Capacidad reservada del arreglo de bloques.
+    int capacidadBloques;
+    /// @brief Estado del codificador de valores para el último bloque (el abierto).
+    typename Codificador<T>::Estado estado;
+    /// @brief Estado del codificador de tiempos para el último bloque.
+    CodificadorTiempos::Estado estadoTiempos;
+    /// @brief Número de muestras vivas en toda la serie.
+    int tamano;
+
+    /**
+     * @brief Abre un bloque nuevo al final, cerrando el anterior.
+     */
+    void abrirBloque() {
+        if (numBloques > 0) {
+            bloques[numBloques - 1]->ajustar();
+        }
+        if (numBloques == capacidadBloques) {
+            int nuevaCapacidad = (capacidadBloques == 0) ? 8 : capacidadBloques * 2;
+            BloqueComprimido<T>** nuevos = new BloqueComprimido<T>*[nuevaCapacidad];
+            for (int i = 0; i < numBloques; i++) nuevos[i] = bloques[i];
+            delete[] bloques;
+            bloques = nuevos;
+            capacidadBloques = nuevaCapacidad;
+        }
+        bloques[numBloques++] = new BloqueComprimido<T>();
+        Codificador<T>::iniciar(estado);
+        CodificadorTiempos::iniciar(estadoTiempos);
+    }
+
+    /**
+     * @brief Busca el primer bloque cuyo rango de tiempo termina en o después de `t`.
+     * @details Búsqueda binaria sobre `tFin`, que crece con los bloques.
+     * @return El índice del bloque, o numBloques si no hay ninguno.
+     */
+    int buscarBloque(MarcaTiempo t) const {
+        int izq = 0;
+        int der = numBloques;
+        while (izq < der) {
+            int medio = (izq + der) / 2;
+            if (bloques[medio]->tFin < t) {
+                izq = medio + 1;
+            } else {
+                der = medio;
+            }
+        }
+        return izq;
+    }
+
+    /**
+     * @brief Copia profunda de los bloques de otra serie.
+     */
+    void copiarDesde(const SerieComprimida<T>& otra) {
+        numBloques = otra.numBloques;
+        capacidadBloques = otra.numBloques;
+        bloques = (numBloques > 0) ? new BloqueComprimido<T>*[numBloques] : nullptr;
+        for (int i = 0; i < numBloques; i++) {
+            bloques[i] = otra.bloques[i]->clonar();
+        }
+        estado = otra.estado;
+        estadoTiempos = otra.estadoTiempos;
+        tamano = otra.tamano;
+    }
+
+    /**
+     * @brief Libera todos los bloques.
+     */
+    void limpiar() {
+        for (int i = 0; i < numBloques; i++) {
+            delete bloques[i];
+        }
+        delete[] bloques;
+        bloques = nullptr;
+        numBloques = 0;
+        capacidadBloques = 0;
+        tamano = 0;
+    }
+
+public:
+    /**
+     * @brief Constructor por defecto. Crea una serie vacía.
+     */
+    SerieComprimida() : bloques(nullptr), numBloques(0), capacidadBloques(0), tamano(0) {
+        Codificador<T>::iniciar(estado);
+        CodificadorTiempos::iniciar(estadoTiempos);
+    }
+
+    /**
+     * @brief Destructor (Regla de los Tres).
+     */
+    ~SerieComprimida() {
+        limpiar();
+    }
+
+    /**
+     * @brief Constructor de Copia (Regla de los Tres).
+     */
+    SerieComprimida(const SerieComprimida<T>& otra) {
+        copiarDesde(otra);
+    }
+
+    /**
+     * @brief Operador de Asignación (Regla de los Tres).
+     */
+    SerieComprimida<T>& operator=(const SerieComprimida<T>& otra) {
+        if (this != &otra) {
+            limpiar();
+            copiarDesde(otra);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Anexa una muestra al final de la serie.
+     * @param valor La muestra a codificar.
+     * @param tiempo Su marca de tiempo (no menor que la de la muestra anterior).
+     */
+    void agregar(T valor, MarcaTiempo tiempo) {
+        if (numBloques == 0 || bloques[numBloques - 1]->cantidad == BloqueComprimido<T>::MAX_MUESTRAS) {
+            abrirBloque();
+        }
+        BloqueComprimido<T>* b = bloques[numBloques - 1];
+
+        b->valores.reservar(Codificador<T>::MAX_BITS);
+        EscritorBits escritor(b->valores.datos, b->valores.bits);
+        Codificador<T>::codificar(estado, escritor, valor);
+        b->valores.bits = escritor.getBits();
+
+        b->tiempos.reservar(CodificadorTiempos::MAX_BITS);
+        EscritorBits escritorTiempos(b->tiempos.datos, b->tiempos.bits);
+        CodificadorTiempos::codificar(estadoTiempos, escritorTiempos, tiempo);
+        b->tiempos.bits = escritorTiempos.getBits();
+
+        if (b->cantidad == 0) b->tInicio = tiempo;
+        b->tFin = tiempo;
+        b->cantidad++;
+        b->acumular(valor);
+        tamano++;
+    }
+
+    /**
+     * @brief Agrega las muestras vivas con marca de tiempo en [t0, t1].
+     * @details Ubica el primer bloque por búsqueda binaria. Los bloques
+     * contenidos por completo en el rango aportan su resumen sin
+     * decodificarse; solo los de los extremos se decodifican (ambas columnas).
+     * @param t0 Inicio del rango (inclusive).
+     * @param t1 Fin del rango (inclusive).
+     * @return El agregado de las muestras del rango.
+     */
+    Agregado agregarRango(MarcaTiempo t0, MarcaTiempo t1) const {
+        Agregado a;
+        for (int i = buscarBloque(t0); i < numBloques && bloques[i]->tInicio <= t1; i++) {
+            const BloqueComprimido<T>* b = bloques[i];
+            if (t0 <= b->tInicio && b->tFin <= t1) {
+                b->combinarResumen(a);
+                continue;
+            }
+            typename Codificador<T>::Estado e;
+            CodificadorTiempos::Estado et;
+            Codificador<T>::iniciar(e);
+            CodificadorTiempos::iniciar(et);
+            LectorBits lector(b->valores.datos);
+            LectorBits lectorTiempos(b->tiempos.datos);
+            for (int j = 0; j < b->cantidad; j++) {
+                T v = Codificador<T>::decodificar(e, lector);
+                MarcaTiempo t = CodificadorTiempos::decodificar(et, lectorTiempos);
+                if (t > t1) break;
+                if (t >= t0 && !b->estaEliminada(j)) a.acumular(v);
+            }
+        }
+        return a;
+    }
+
+    /**
+     * @brief Elimina la muestra viva de menor valor.
+     * @details Localiza el bloque por su resumen en O(bloques) y decodifica
+     * solo ese bloque para marcar la muestra y recalcular su resumen.
+     * @param[out] valor Recibe el valor eliminado.
+     * @return true si se eliminó una muestra, false si la serie estaba vacía.
+     */
+    bool extraerMinimo(T& valor) {
+        BloqueComprimido<T>* elegido = nullptr;
+        for (int i = 0; i < numBloques; i++) {
+            BloqueComprimido<T>* b = bloques[i];
+            if (b->vivas > 0 && (elegido == nullptr || b->minimo < elegido->minimo)) {
+                elegido = b;
+            }
+        }
+        if (elegido == nullptr) return false;
+
+        typename Codificador<T>::Estado e;
+        Codificador<T>::iniciar(e);
+        LectorBits lector(elegido->valores.datos);
+        for (int i = 0; i < elegido->cantidad; i++) {
+            T v = Codificador<T>::decodificar(e, lector);
+            if (!elegido->estaEliminada(i) && !(elegido->minimo < v)) {
+                valor = v;
+                elegido->marcarEliminada(i);
+                break;
+            }
+        }
+        elegido->recalcularResumen();
+        tamano--;
+        return true;
+    }
+
+    /**
+     * @brief Retira el bloque más antiguo y entrega su propiedad al llamador.
+     * @details El bloque abierto (el último) nunca se retira.
+     * @return El bloque retirado (el llamador debe liberarlo), o nullptr si
+     * la serie tiene menos de dos bloques.
+     */
+    BloqueComprimido<T>* extraerPrimerBloque() {
+        if (numBloques < 2) return nullptr;
+        BloqueComprimido<T>* primero = bloques[0];
+        for (int i = 1; i < numBloques; i++) bloques[i - 1] = bloques[i];
+        numBloques--;
+        tamano -= primero->vivas;
+        return primero;
+    }
+
+    /**
+     * @brief Suma de las muestras vivas, a partir de los resúmenes de bloque.
+     */
+    double getSuma() const {
+        double suma = 0;
+        for (int i = 0; i < numBloques; i++) suma += bloques[i]->suma;
+        return suma;
+    }
+
+    /**
+     * @brief Obtiene el número de muestras vivas.
+     */
+    int getTamano() const { return tamano; }
+
+    /**
+     * @brief Obtiene el número de bloques.
+     */
+    int getNumBloques() const { return numBloques; }
+
+    /**
+     * @brief Obtiene el bloque `i` (solo lectura).
+     */
+    const BloqueComprimido<T>* getBloque(int i) const { return bloques[i]; }
+
+    /**
+     * @brief Memoria total ocupada por la serie, en bytes.
+     */
+    long bytesUsados() const {
+        long total = (long)sizeof(*this) + capacidadBloques * (long)sizeof(BloqueComprimido<T>*);
+        for (int i = 0; i < numBloques; i++) total += bloques[i]->bytesUsados();
+        return total;
+    }
+};
+
+/**
+ * @class LectorSerie
+ * @brief Recorre una SerieComprimida decodificando en streaming.
+ * @details Mantiene solo el estado del codificador del bloque actual, por lo
+ * que un recorrido completo no reserva memoria. Omite las muestras eliminadas.
+ * La columna de tiempos solo se decodifica si se pide al construirlo.
+ * @tparam T El tipo de dato de las muestras.
+ */
+template <typename T>
+class LectorSerie {
+private:
+    /// @brief Serie que se recorre.
+    const SerieComprimida<T>& serie;
+    /// @brief Índice del bloque actual.
+    int bloque;
+    /// @brief Índice de la siguiente muestra dentro del bloque actual.
+    int indice;
+    /// @brief Estado del codificador para el bloque actual.
+    typename Codificador<T>::Estado estado;
+    /// @brief Lector de bits sobre la columna de valores del bloque actual.
+    LectorBits lector;
+    /// @brief Indica si también se decodifica la columna de tiempos.
+    bool conTiempos;
+    /// @brief Estado del codificador de tiempos para el bloque actual.
+    CodificadorTiempos::Estado estadoTiempos;
+    /// @brief Lector de bits sobre la columna de tiempos del bloque actual.
+    LectorBits lectorTiempos;
+    /// @brief Marca de tiempo de la última muestra entregada.
+    MarcaTiempo tiempo;
+
+    /**
+     * @brief Prepara los lectores para el bloque actual.
+     */
+    void abrirBloque() {
+        Codificador<T>::iniciar(estado);
+        CodificadorTiempos::iniciar(estadoTiempos);
+        if (bloque < serie.getNumBloques()) {
+            lector = LectorBits(serie.getBloque(bloque)->valores.datos);
+            lectorTiempos = LectorBits(serie.getBloque(bloque)->tiempos.datos);
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor. Se posiciona antes de la primera muestra.
+     * @param s La serie a recorrer.
+     * @param leerTiempos true para decodificar también las marcas de tiempo.
+     */
+    LectorSerie(const SerieComprimida<T>& s, bool leerTiempos = false)
+        : serie(s), bloque(0), indice(0), lector(nullptr), conTiempos(leerTiempos),
+          lectorTiempos(nullptr), tiempo(0) {
+        abrirBloque();
+    }
+
+    /**
+     * @brief Avanza a la siguiente muestra viva.
+     * @param[out] valor Recibe la muestra decodificada.
+     * @return false si ya no hay más muestras.
+     */
+    bool siguiente(T& valor) {
+        while (bloque < serie.getNumBloques()) {
+            const BloqueComprimido<T>* b = serie.getBloque(bloque);
+            if (indice < b->cantidad) {
+                valor = Codificador<T>::decodificar(estado, lector);
+                if (conTiempos) tiempo = CodificadorTiempos::decodificar(estadoTiempos, lectorTiempos);
+                if (!b->estaEliminada(indice++)) return true;
+                continue;
+            }
+            bloque++;
+            indice = 0;
+            abrirBloque();
+        }
+        return false;
+    }
+
+    /**
+     * @brief Marca de tiempo de la última muestra entregada (requiere `leerTiempos`).
+     */
+    MarcaTiempo getTiempo() const { return tiempo; }
+};
+
+#endif
@@ -6,57 +6,177 @@
  */
 
 #include "Sistema.h"
+#include "Exportador.h"
 #include <cstring> // Para strcmp
 
-Sistema::Sistema() {}
+Sistema::Sistema()
+    : pendientes(nullptr), numPendientes(0), capacidadPendientes(0),
+      enPendientes(nullptr), capacidadRanuras(0) {}
 
 Sistema::~Sistema() {
+    delete[] pendientes;
+    delete[] enPendientes;
     std::cout << "--- Liberacion de Memoria en Cascada ---" << std::endl;
-    // Iteramos la lista de gestión
-    Nodo<SensorBase*>* actual = listaGestion.getCabeza();
-    while (actual != nullptr) {
-        std::cout << "[Destructor General] Liberando Nodo: " << actual->dato->getNombre() << "." << std::endl;
-        
-        // 1. Liberamos el objeto Sensor (SensorTemperatura o SensorPresion)
-        // Gracias al destructor VIRTUAL, se llama al destructor correcto.
-        delete actual->dato; 
-        
-        // 2. El destructor de ListaSensor<SensorBase*> (que se llama solo)
-        // se encargará de liberar el 'Nodo' en sí.
-        
-        actual = actual->siguiente;
+    for (int i = 0; i < registro.getTamano(); i++) {
+        std::cout << "[Destructor General] Liberando Sensor: " << registro.getDenso(i)->getNombre() << "." << std::endl;
+    }
+    // El destructor de 'registro' se llama al final: aplica el destructor
+    // VIRTUAL a cada sensor (se llama al destructor correcto) y libera la arena.
+}
+
+void Sistema::reservarRanura(int ranura) {
+    if (ranura < capacidadRanuras) return;
+    int nuevaCapacidad = (capacidadRanuras == 0) ? RegistroSensores::CELDAS_POR_BLOQUE : capacidadRanuras;
+    while (nuevaCapacidad <= ranura) nuevaCapacidad *= 2;
+    bool* nuevas = new bool[nuevaCapacidad];
+    for (int i = 0; i < nuevaCapacidad; i++) nuevas[i] = (i < capacidadRanuras) ? enPendientes[i] : false;
+    delete[] enPendientes;
+    enPendientes = nuevas;
+    capacidadRanuras = nuevaCapacidad;
+}
+
+bool Sistema::eliminarSensor(ManejadorSensor h) {
+    if (!registro.eliminar(h)) return false;
+    alertas.liberarRanura((int)h.indice);
+    // Su entrada en 'pendientes' queda obsoleta y procesarTodos() la salta;
+    // la ranura puede reutilizarse y volver a anotarse.
+    enPendientes[h.indice] = false;
+    return true;
+}
+
+bool Sistema::marcarPendiente(ManejadorSensor h) {
+    if (registro.obtener(h) == nullptr) return false;
+    if (enPendientes[h.indice]) return true;
+    if (numPendientes == capacidadPendientes) {
+        int nuevaCapacidad = (capacidadPendientes == 0) ? RegistroSensores::CELDAS_POR_BLOQUE : capacidadPendientes * 2;
+        ManejadorSensor* nuevos = new ManejadorSensor[nuevaCapacidad];
+        for (int i = 0; i < numPendientes; i++) nuevos[i] = pendientes[i];
+        delete[] pendientes;
+        pendientes = nuevos;
+        capacidadPendientes = nuevaCapacidad;
     }
-    // El destructor de 'listaGestion' se llama al final, limpiando los Nodos
-    // (pero no los datos a los que apuntaban, por eso el 'delete' de arriba es vital)
+    pendientes[numPendientes++] = h;
+    enPendientes[h.indice] = true;
+    return true;
 }
 
-void Sistema::agregarSensor(SensorBase* sensor) {
-    listaGestion.insertarAlFinal(sensor);
+bool Sistema::configurarRetencion(ManejadorSensor h, int maxCrudas) {
+    SensorBase* sensor = registro.obtener(h);
+    if (sensor == nullptr) return false;
+    sensor->configurarRetencion(maxCrudas);
+    marcarPendiente(h); // La suma de las crudas puede cambiar
+    return true;
 }
 
-SensorBase* Sistema::buscarSensor(const char* nombre) {
-    Nodo<SensorBase*>* actual = listaGestion.getCabeza();
-    while (actual != nullptr) {
+SensorBase* Sistema::obtenerSensor(ManejadorSensor h) const {
+    return registro.obtener(h);
+}
+
+ManejadorSensor Sistema::buscarManejador(const char* nombre) const {
+    for (int i = 0; i < registro.getTamano(); i++) {
         // Comparamos C-strings
-        if (strcmp(actual->dato->getNombre(), nombre) == 0) {
-            return actual->dato;
+        if (strcmp(registro.getDenso(i)->getNombre(), nombre) == 0) {
+            return registro.manejadorDe(i);
         }
-        actual = actual->siguiente;
     }
-    return nullptr; // No encontrado
+    return ManejadorSensor(); // No encontrado
+}
+
+SensorBase* Sistema::buscarSensor(const char* nombre) const {
+    return registro.obtener(buscarManejador(nombre));
+}
+
+bool Sistema::registrarNuevaLectura(ManejadorSensor h, Serial& port) {
+    SensorBase* sensor = registro.obtener(h);
+    if (sensor == nullptr) return false;
+
+    // Polimorfismo: Llama al método 'registrarNuevaLectura'
+    // apropiado (Temp o Presion).
+    sensor->registrarNuevaLectura(port);
+    marcarPendiente(h);
+    evaluarAlertas(h);
+    return true;
+}
+
+bool Sistema::registrarDesdeTexto(ManejadorSensor h, const char* texto) {
+    SensorBase* sensor = registro.obtener(h);
+    if (sensor == nullptr || !sensor->registrarDesdeTexto(texto)) return false;
+
+    marcarPendiente(h);
+    evaluarAlertas(h);
+    return true;
 }
 
-void Sistema::procesarTodos() {
+int Sistema::evaluarAlertas(ManejadorSensor h) {
+    SensorBase* sensor = registro.obtener(h);
+    if (sensor == nullptr || !sensor->tieneLecturas()) return 0;
+    return alertas.evaluar(h, sensor->getUltimoValor(), sensor->getUltimoTiempo());
+}
+
+void Sistema::definirAlertaTipo(TipoSensor tipo, const ReglaAlerta& regla) {
+    alertas.definirReglaTipo(tipo, regla);
+}
+
+bool Sistema::definirAlertaSensor(ManejadorSensor h, const ReglaAlerta& regla) {
+    if (registro.obtener(h) == nullptr) return false;
+    alertas.definirReglaSensor((int)h.indice, regla);
+    return true;
+}
+
+bool Sistema::exportar(Exportador& exportador) const {
+    for (int i = 0; i < registro.getTamano(); i++) {
+        registro.getDenso(i)->exportar(exportador);
+    }
+    return exportador.terminar();
+}
+
+int Sistema::procesarTodos() {
     std::cout << "\n--- Ejecutando Polimorfismo ---" << std::endl;
-    Nodo<SensorBase*>* actual = listaGestion.getCabeza();
-    while (actual != nullptr) {
-        std::cout << "-> Procesando Sensor " << actual->dato->getNombre() << "..." << std::endl;
+    int procesados = 0;
+    for (int i = 0; i < numPendientes; i++) {
+        SensorBase* sensor = registro.obtener(pendientes[i]);
+        if (sensor == nullptr) continue; // Eliminado después de anotarse
+        enPendientes[pendientes[i].indice] = false;
+        std::cout << "-> Procesando Sensor " << sensor->getNombre() << "..." << std::endl;
         
         // ¡La magia del polimorfismo!
         // Llama a SensorTemperatura::procesarLectura() o 
         // SensorPresion::procesarLectura() según corresponda.
-        actual->dato->procesarLectura();
-        
-        actual = actual->siguiente;
+        sensor->procesarLectura();
+        procesados++;
+    }
+    numPendientes = 0;
+
+    // Los demás conservan su resultado anterior: una sola línea para todos
+    int sinCambios = registro.getTamano() - procesados;
+    if (sinCambios > 0) {
+        std::cout << "-> " << sinCambios << " sensor(es) sin cambios (resultado en cache)." << std::endl;
+    }
+    return procesados;
+}
+
+void Sistema::imprimirResultados() const {
+    for (int i = 0; i < registro.getTamano(); i++) {
+        registro.getDenso(i)->imprimirResultado();
+    }
+}
+
+void Sistema::imprimirAlerta(const Alerta& alerta, void* contexto) {
+    Sistema* sistema = static_cast<Sistema*>(contexto);
+    SensorBase* sensor = sistema->obtenerSensor(alerta.sensor);
+    const char* nombre = (sensor != nullptr) ? sensor->getNombre() : "?";
+
+    std::cout << "[ALERTA] " << nombre << ": ";
+    switch (alerta.tipo) {
+        case ALERTA_MAXIMO:
+            std::cout << "lectura " << alerta.valor << " sobre el maximo " << alerta.limite;
+            break;
+        case ALERTA_MINIMO:
+            std::cout << "lectura " << alerta.valor << " bajo el minimo " << alerta.limite;
+            break;
+        case ALERTA_CAMBIO_BRUSCO:
+            std::cout << "cambio de " << alerta.valor << "/s (limite " << alerta.limite << "/s)";
+            break;
     }
+    std::cout << "." << std::endl;
 }
\ No newline at end of file
@@ -6,22 +6,45 @@
 #define SISTEMA_H
 
 #include "Sensor.h" 
-// Sensor.h ya incluye ListaSensor.h
+#include "RegistroSensores.h"
+#include "Alertas.h"
 
 /**
  * @class Sistema
- * @brief Clase principal que gestiona la lista polimórfica de sensores.
- * @details Contiene la lista de gestión principal que almacena punteros
- * SensorBase* y orquesta las operaciones principales.
+ * @brief Clase principal que gestiona el registro polimórfico de sensores.
+ * @details Contiene el registro de gestión principal, que guarda los
+ * sensores en una arena contigua, y orquesta las operaciones principales.
  */
 class Sistema {
 private:
     /**
-     * @brief La "Lista de Gestión Polimórfica".
-     * @details Almacena punteros a SensorBase, permitiendo que
-     * SensorTemperatura y SensorPresion coexistan en la misma lista.
+     * @brief El "Registro de Gestión Polimórfico".
+     * @details Guarda SensorTemperatura y SensorPresion en la misma arena
+     * contigua y los recorre como SensorBase* desde un arreglo denso, así que
+     * recorrerlos no salta entre nodos y objetos dispersos en el heap.
      */
-    ListaSensor<SensorBase*> listaGestion;
+    RegistroSensores registro;
+
+    /**
+     * @brief Reglas de alerta, compiladas por ranura del registro.
+     */
+    MotorAlertas alertas;
+
+    /// @brief Sensores con lecturas nuevas desde el último procesarTodos(), sin repetidos.
+    ManejadorSensor* pendientes;
+    /// @brief Manejadores en `pendientes`.
+    int numPendientes;
+    /// @brief Capacidad de `pendientes`.
+    int capacidadPendientes;
+    /// @brief Por ranura del registro: true si su sensor ya está en `pendientes`.
+    bool* enPendientes;
+    /// @brief Capacidad de `enPendientes`.
+    int capacidadRanuras;
+
+    /**
+     * @brief Asegura que `enPendientes` tenga lugar para una ranura.
+     */
+    void reservarRanura(int ranura);
 
 public:
     /**
@@ -31,34 +54,163 @@ public:
     
     /**
      * @brief Destructor de Sistema.
-     * @details Inicia la "Liberación de Memoria en Cascada". Itera sobre la
-     * listaGestion y aplica `delete` a cada puntero `SensorBase*`.
-     * Gracias al destructor virtual de SensorBase, esto llama al
-     * destructor correcto (ej. ~SensorTemperatura), que a su vez libera
-     * su lista interna.
+     * @details Inicia la "Liberación de Memoria en Cascada". Al destruirse el
+     * registro, cada sensor se destruye con su destructor virtual (ej.
+     * ~SensorTemperatura), que a su vez libera su historial interno.
      */
     ~Sistema();
 
     /**
-     * @brief Agrega un nuevo sensor (ya creado) a la lista de gestión.
-     * @param sensor Un puntero de tipo SensorBase* al objeto a agregar.
+     * @brief Crea un nuevo sensor dentro del registro de gestión.
+     * @tparam S SensorTemperatura o SensorPresion.
+     * @param nombre El nombre (ID) del sensor.
+     * @param modo Estructura del historial del sensor.
+     * @return El manejador del nuevo sensor.
+     */
+    template <typename S>
+    ManejadorSensor agregarSensor(const char* nombre, ModoHistorial modo = HISTORIAL_LISTA) {
+        ManejadorSensor h = registro.crear<S>(nombre, modo);
+        alertas.asignarRanura((int)h.indice, registro.obtener(h)->getTipo());
+        reservarRanura((int)h.indice);
+        marcarPendiente(h); // El primer procesarTodos() calcula su resultado inicial
+        return h;
+    }
+
+    /**
+     * @brief Elimina un sensor del registro en O(1), liberando su historial.
+     * @param h El manejador del sensor.
+     * @return false si el manejador ya no es válido.
+     */
+    bool eliminarSensor(ManejadorSensor h);
+
+    /**
+     * @brief Obtiene el sensor de un manejador.
+     * @return El sensor, o `nullptr` si fue eliminado.
      */
-    void agregarSensor(SensorBase* sensor);
+    SensorBase* obtenerSensor(ManejadorSensor h) const;
     
     /**
-     * @brief Busca un sensor en la lista de gestión por su nombre (ID).
+     * @brief Busca un sensor en el registro de gestión por su nombre (ID).
+     * @param nombre El C-string del ID del sensor a buscar.
+     * @return El manejador del sensor (inválido si no se encuentra).
+     */
+    ManejadorSensor buscarManejador(const char* nombre) const;
+
+    /**
+     * @brief Busca un sensor en el registro de gestión por su nombre (ID).
      * @param nombre El C-string del ID del sensor a buscar.
      * @return Un puntero SensorBase* al sensor si se encuentra, o `nullptr` si no.
      */
-    SensorBase* buscarSensor(const char* nombre);
+    SensorBase* buscarSensor(const char* nombre) const;
+
+    /**
+     * @brief Registra una nueva lectura desde el puerto y evalúa sus alertas.
+     * @details Llama al `registrarNuevaLectura()` polimórfico del sensor y
+     * luego evalúa las reglas de alerta sobre la lectura recién ingresada,
+     * en O(1): la detección ocurre al ingresar, sin esperar a procesarTodos().
+     * @param h El manejador del sensor.
+     * @param port Referencia al objeto Serial.
+     * @return false si el manejador ya no es válido.
+     */
+    bool registrarNuevaLectura(ManejadorSensor h, Serial& port);
+
+    /**
+     * @brief Registra una lectura ya recibida como texto y evalúa sus alertas.
+     * @details Variante sin espera de registrarNuevaLectura(), para quien ya
+     * leyó y separó la línea del puerto (ej. el Demonio).
+     * @param h El manejador del sensor.
+     * @param texto El valor, sin el prefijo.
+     * @return false si el manejador ya no es válido o el texto no es un
+     * valor del tipo del sensor (no se registra nada).
+     */
+    bool registrarDesdeTexto(ManejadorSensor h, const char* texto);
+
+    /**
+     * @brief Anota que un sensor tiene datos nuevos para el próximo procesarTodos().
+     * @details registrarNuevaLectura(), registrarDesdeTexto() y
+     * configurarRetencion() ya lo hacen; hay que llamarlo tras ingresar
+     * lecturas directamente en el sensor (ej. agregarLectura). O(1).
+     * @return false si el manejador ya no es válido.
+     */
+    bool marcarPendiente(ManejadorSensor h);
+
+    /**
+     * @brief Cambia la retención de un sensor y lo anota para reprocesarlo.
+     * @param h El manejador del sensor.
+     * @param maxCrudas Lecturas crudas a conservar (0 = sin límite).
+     * @return false si el manejador ya no es válido.
+     */
+    bool configurarRetencion(ManejadorSensor h, int maxCrudas);
+
+    /**
+     * @brief Evalúa las alertas sobre la última lectura de un sensor.
+     * @details Para lecturas ingresadas sin pasar por registrarNuevaLectura()
+     * (ej. agregarLectura directo).
+     * @return Número de alertas emitidas.
+     */
+    int evaluarAlertas(ManejadorSensor h);
+
+    /**
+     * @brief Callback de alertas que las imprime con el nombre del sensor.
+     * @details Para registrar con configurarCallback(), pasando el Sistema
+     * como contexto.
+     * @param alerta La alerta emitida.
+     * @param contexto Puntero al Sistema dueño del sensor.
+     */
+    static void imprimirAlerta(const Alerta& alerta, void* contexto);
+
+    /**
+     * @brief Define la regla de alerta de todos los sensores de un tipo.
+     */
+    void definirAlertaTipo(TipoSensor tipo, const ReglaAlerta& regla);
+
+    /**
+     * @brief Define la regla de alerta propia de un sensor (tiene prioridad sobre la de su tipo).
+     * @return false si el manejador ya no es válido.
+     */
+    bool definirAlertaSensor(ManejadorSensor h, const ReglaAlerta& regla);
+
+    /**
+     * @brief Exporta las lecturas crudas de todos los sensores.
+     * @details Cada sensor recorre su historial en streaming hacia el
+     * exportador; no se copia ningún historial. Las lecturas que lleguen
+     * durante la exportación no se incluyen (ver HistorialSensor::recorrer).
+     * Debe llamarse desde el hilo que ingresa las lecturas (como hacen el
+     * menú y el Demonio), salvo que todos los sensores usen
+     * HISTORIAL_CONCURRENTE: en los demás modos el recorrido no está
+     * sincronizado con el ingreso.
+     * @param exportador Un exportador ya abierto; se cierra al terminar.
+     * @return false si alguna escritura falló.
+     */
+    bool exportar(Exportador& exportador) const;
+
+    /**
+     * @brief Acceso al motor de alertas (callback y cola de alertas).
+     */
+    MotorAlertas& getAlertas() { return alertas; }
+    const MotorAlertas& getAlertas() const { return alertas; }
 
     /**
      * @brief Ejecuta el procesamiento polimórfico.
-     * @details Itera sobre la listaGestion y llama al método `procesarLectura()`
-     * de cada sensor. El polimorfismo asegura que se ejecute la
-     * implementación correcta (Temp o Presion).
+     * @details Recorre solo los sensores pendientes (con lecturas nuevas
+     * desde la llamada anterior) y llama al método `procesarLectura()` de
+     * cada uno. El polimorfismo asegura que se ejecute la implementación
+     * correcta (Temp o Presion). El costo es O(pendientes), no O(sensores):
+     * los que no cambiaron no se visitan ni se imprimen, solo se informa
+     * cuántos son (su resultado en cache está en imprimirResultados()).
+     * @return El número de sensores que se procesaron.
+     */
+    int procesarTodos();
+
+    /**
+     * @brief Imprime el último resultado de cada sensor, sin reprocesar ninguno.
      */
-    void procesarTodos();
+    void imprimirResultados() const;
+
+private:
+    // No copiable: es dueño de los arreglos de pendientes.
+    Sistema(const Sistema&);
+    Sistema& operator=(const Sistema&);
 };
 
 #endif
\ No newline at end of file
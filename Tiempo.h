@@ -0,0 +1,96 @@
+/**
+ * @file Tiempo.h
+ * @brief Define las marcas de tiempo monotónicas y el resultado de las consultas por rango.
+ */
+#ifndef TIEMPO_H
+#define TIEMPO_H
+
+#include <stdint.h>
+#include <time.h> // Para clock_gettime (POSIX)
+
+/// @brief Marca de tiempo monotónica, en milisegundos desde un origen arbitrario.
+typedef uint64_t MarcaTiempo;
+
+/**
+ * @brief Obtiene la marca de tiempo actual.
+ * @details Usa CLOCK_MONOTONIC, que no retrocede si se ajusta la hora del sistema.
+ * @return Milisegundos transcurridos desde un origen fijo.
+ */
+inline MarcaTiempo tiempoActual() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (MarcaTiempo)ts.tv_sec * 1000 + (MarcaTiempo)(ts.tv_nsec / 1000000);
+}
+
+/**
+ * @struct Lectura
+ * @brief Una lectura con su marca de tiempo, tal como se guarda en modo lista.
+ * @details Se compara por valor, para que ListaSensor y HeapMinimos la
+ * traten igual que al dato desnudo.
+ * @tparam T El tipo del valor (float o int).
+ */
+template <typename T>
+struct Lectura {
+    /// @brief Momento de llegada de la lectura.
+    MarcaTiempo tiempo;
+    /// @brief Valor leído.
+    T valor;
+
+    /**
+     * @brief Compara por valor.
+     */
+    bool operator<(const Lectura<T>& otra) const { return valor < otra.valor; }
+
+    /**
+     * @brief Compara por valor.
+     */
+    bool operator!=(const Lectura<T>& otra) const { return valor != otra.valor; }
+};
+
+/**
+ * @struct Agregado
+ * @brief Resultado de una consulta agregada (cantidad, suma, mínimo, máximo).
+ */
+struct Agregado {
+    /// @brief Número de lecturas consideradas.
+    int cantidad;
+    /// @brief Suma de las lecturas.
+    double suma;
+    /// @brief Lectura mínima (válida solo si cantidad > 0).
+    double minimo;
+    /// @brief Lectura máxima (válida solo si cantidad > 0).
+    double maximo;
+
+    /**
+     * @brief Constructor. Crea un agregado vacío.
+     */
+    Agregado() : cantidad(0), suma(0), minimo(0), maximo(0) {}
+
+    /**
+     * @brief Incorpora una lectura.
+     */
+    void acumular(double v) {
+        if (cantidad == 0 || v < minimo) minimo = v;
+        if (cantidad == 0 || v > maximo) maximo = v;
+        suma += v;
+        cantidad++;
+    }
+
+    /**
+     * @brief Incorpora otro agregado completo (ej. el resumen de un bloque).
+     */
+    void combinar(const Agregado& otro) {
+        if (otro.cantidad == 0) return;
+        if (cantidad == 0 || otro.minimo < minimo) minimo = otro.minimo;
+        if (cantidad == 0 || otro.maximo > maximo) maximo = otro.maximo;
+        suma += otro.suma;
+        cantidad += otro.cantidad;
+    }
+
+    /**
+     * @brief Obtiene el promedio (0 si no hay lecturas).
+     */
+    double promedio() const { return (cantidad > 0) ? suma / cantidad : 0; }
+};
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file Cronometro.h
+ * @brief Utilidades comunes de los benchmarks: cronómetro y señales de prueba.
+ */
+#ifndef CRONOMETRO_H
+#define CRONOMETRO_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib> // Para atol
+#include <iostream>
+
+/**
+ * @class Cronometro
+ * @brief Mide el tiempo transcurrido desde su creación (o desde reiniciar()).
+ */
+class Cronometro {
+private:
+    /// @brief Instante de inicio.
+    std::chrono::steady_clock::time_point inicio;
+
+public:
+    /**
+     * @brief Constructor. Empieza a medir.
+     */
+    Cronometro() : inicio(std::chrono::steady_clock::now()) {}
+
+    /**
+     * @brief Vuelve a empezar a medir.
+     */
+    void reiniciar() { inicio = std::chrono::steady_clock::now(); }
+
+    /**
+     * @brief Segundos transcurridos.
+     */
+    double segundos() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    }
+};
+
+/**
+ * @brief Lee el argumento `i` como entero, o devuelve `porDefecto` si no está.
+ */
+inline long argumento(int argc, char* argv[], int i, long porDefecto) {
+    return (argc > i) ? atol(argv[i]) : porDefecto;
+}
+
+/**
+ * @brief Temperatura simulada: oscilación lenta más ruido, con resolución de 0.1 grados.
+ * @details Es el formato que envía el Arduino ("T:23.4"). Determinista
+ * para una semilla de srand() dada.
+ * @param i Número de muestra.
+ */
+inline float temperaturaSimulada(long i) {
+    double valor = 22.0 + 3.0 * std::sin(i / 5000.0) + (rand() % 5 - 2) * 0.1;
+    return (float)(std::floor(valor * 10.0 + 0.5) / 10.0);
+}
+
+/**
+ * @brief Presión simulada: variación lenta más ruido de +-2 unidades.
+ */
+inline int presionSimulada(long i) {
+    return 1013 + (int)(20.0 * std::sin(i / 20000.0)) + (rand() % 5 - 2);
+}
+
+/**
+ * @class SilenciarCout
+ * @brief Descarta la salida de std::cout mientras existe (los sensores imprimen al procesar).
+ */
+class SilenciarCout {
+private:
+    /// @brief Buffer original de std::cout.
+    std::streambuf* original;
+
+public:
+    /**
+     * @brief Constructor. Desconecta std::cout de su buffer.
+     */
+    SilenciarCout() : original(std::cout.rdbuf(nullptr)) {}
+
+    /**
+     * @brief Destructor. Restaura el buffer y limpia el estado de error.
+     */
+    ~SilenciarCout() {
+        std::cout.rdbuf(original);
+        std::cout.clear();
+    }
+
+private:
+    // No copiable.
+    SilenciarCout(const SilenciarCout&);
+    SilenciarCout& operator=(const SilenciarCout&);
+};
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file bench_compresion.cpp
+ * @brief Benchmark de memoria y velocidad de recorrido de HistorialSensor por modo.
+ * @details Llena un historial en modo lista y otro en modo comprimido con
+ * la misma señal simulada (temperatura float con resolución 0.1 y presión
+ * int), mide los bytes por lectura con bytesUsados(), recorre ambos con
+ * recorrer() y verifica que el comprimido devuelva exactamente los mismos
+ * valores.
+ *
+ * Uso: bench_compresion [lecturas=1000000] [recorridos=5]
+ */
+
+#include "Historial.h"
+#include "Cronometro.h"
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @struct Verificador
+ * @brief Visitante de recorrer(): compara cada lectura con la esperada y acumula la suma.
+ */
+template <typename T>
+struct Verificador {
+    /// @brief Valores esperados, en orden.
+    const T* esperados;
+    /// @brief Lecturas visitadas.
+    long cantidad;
+    /// @brief Lecturas distintas de la esperada (bit a bit).
+    long errores;
+    /// @brief Suma de los valores (evita que el recorrido se optimice).
+    double suma;
+
+    Verificador(const T* e) : esperados(e), cantidad(0), errores(0), suma(0) {}
+
+    void lectura(MarcaTiempo, T valor) {
+        if (memcmp(&valor, &esperados[cantidad], sizeof(T)) != 0) errores++;
+        suma += valor;
+        cantidad++;
+    }
+};
+
+/**
+ * @brief Llena un historial, mide su memoria y su velocidad de recorrido.
+ * @return Bytes por lectura.
+ */
+template <typename T>
+double medir(const char* etiqueta, ModoHistorial modo, const T* valores, long n, long recorridos) {
+    HistorialSensor<T> historial(modo);
+    historial.configurarRetencion(0); // Sin compactación: se miden solo las crudas
+    for (long i = 0; i < n; i++) {
+        historial.agregar(valores[i], (MarcaTiempo)i * 1000); // Una lectura por segundo
+    }
+    double porLectura = (double)historial.bytesUsados() / n;
+
+    long errores = 0;
+    double suma = 0;
+    Cronometro c;
+    for (long k = 0; k < recorridos; k++) {
+        Verificador<T> v(valores);
+        historial.recorrer(v);
+        errores += v.errores + (n - v.cantidad);
+        suma += v.suma;
+    }
+    double porSegundo = (double)n * recorridos / c.segundos();
+
+    printf("  %-11s %6.2f B/lectura  %7.1f M lecturas/s  %s (suma %.0f)\n", etiqueta, porLectura,
+           porSegundo / 1e6, errores == 0 ? "exacto" : "ERROR: valores distintos", suma);
+    return porLectura;
+}
+
+int main(int argc, char* argv[]) {
+    long n = argumento(argc, argv, 1, 1000000);
+    long recorridos = argumento(argc, argv, 2, 5);
+
+    srand(1);
+    float* temperaturas = new float[n];
+    int* presiones = new int[n];
+    for (long i = 0; i < n; i++) temperaturas[i] = temperaturaSimulada(i);
+    for (long i = 0; i < n; i++) presiones[i] = presionSimulada(i);
+
+    // Referencia: un Nodo<T> mínimo (valor + puntero siguiente) de 16 bytes
+    const double nodoSimple = 16.0;
+
+    printf("Temperatura (float, resolucion 0.1), %ld lecturas\n", n);
+    double listaF = medir<float>("lista", HISTORIAL_LISTA, temperaturas, n, recorridos);
+    double compF = medir<float>("comprimido", HISTORIAL_COMPRIMIDO, temperaturas, n, recorridos);
+    printf("  reduccion: %.1fx frente a un Nodo de 16 B, %.1fx frente al modo lista\n",
+           nodoSimple / compF, listaF / compF);
+
+    printf("Presion (int), %ld lecturas\n", n);
+    double listaI = medir<int>("lista", HISTORIAL_LISTA, presiones, n, recorridos);
+    double compI = medir<int>("comprimido", HISTORIAL_COMPRIMIDO, presiones, n, recorridos);
+    printf("  reduccion: %.1fx frente a un Nodo de 16 B, %.1fx frente al modo lista\n",
+           nodoSimple / compI, listaI / compI);
+
+    delete[] temperaturas;
+    delete[] presiones;
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file bench_concurrente.cpp
+ * @brief Benchmark del modo HISTORIAL_CONCURRENTE: un escritor y N lectores.
+ * @details El escritor ingresa lecturas sin pausa mientras N lectores
+ * alternan agregarTotal() y agregarRango() sobre el último segundo. Se
+ * repite con 0, 1, 2, 4... hasta `lectores` hilos lectores e informa el
+ * ritmo de ingreso y de consultas: como las consultas no toman locks, el
+ * ingreso no debería caer al sumar lectores (salvo por competencia de CPU).
+ *
+ * Uso: bench_concurrente [lectores=8] [duracion_ms=1000] [retencion=10000]
+ */
+
+#include "Historial.h"
+#include "Cronometro.h"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+/**
+ * @struct Compartido
+ * @brief Datos compartidos por el escritor y los lectores de una ronda.
+ */
+struct Compartido {
+    /// @brief El historial medido.
+    HistorialSensor<float> historial;
+    /// @brief Marca de tiempo de la última lectura ingresada.
+    std::atomic<MarcaTiempo> ultimo;
+    /// @brief Fin de la ronda.
+    std::atomic<bool> detener;
+    /// @brief Consultas agregarTotal() hechas por todos los lectores.
+    std::atomic<long> totales;
+    /// @brief Consultas agregarRango() hechas por todos los lectores.
+    std::atomic<long> rangos;
+
+    Compartido() : historial(HISTORIAL_CONCURRENTE), ultimo(0), detener(false), totales(0), rangos(0) {}
+};
+
+/**
+ * @brief Hilo lector: alterna agregarTotal() y agregarRango() del último segundo.
+ */
+static void lector(Compartido* c) {
+    long totales = 0;
+    long rangos = 0;
+    double acumulado = 0;
+    while (!c->detener.load(std::memory_order_relaxed)) {
+        acumulado += c->historial.agregarTotal().suma;
+        totales++;
+        MarcaTiempo t1 = c->ultimo.load(std::memory_order_relaxed);
+        MarcaTiempo t0 = (t1 > 1000) ? t1 - 1000 : 0;
+        acumulado += c->historial.agregarRango(t0, t1).suma;
+        rangos++;
+    }
+    c->totales.fetch_add(totales);
+    c->rangos.fetch_add(rangos);
+    if (acumulado < 0) printf("%f\n", acumulado); // Evita que las consultas se optimicen
+}
+
+/**
+ * @brief Ejecuta una ronda con `numLectores` lectores durante `duracionMs`.
+ */
+static void ronda(int numLectores, long duracionMs, int retencion) {
+    Compartido c;
+    c.historial.configurarRetencion(retencion);
+    std::thread* lectores = new std::thread[numLectores > 0 ? numLectores : 1];
+    for (int i = 0; i < numLectores; i++) lectores[i] = std::thread(lector, &c);
+
+    srand(1);
+    long ingresadas = 0;
+    Cronometro reloj;
+    double limite = duracionMs / 1000.0;
+    while (true) {
+        // Se consulta el reloj cada 1024 lecturas para no medirlo a él
+        for (int k = 0; k < 1024; k++, ingresadas++) {
+            c.historial.agregar(temperaturaSimulada(ingresadas), (MarcaTiempo)ingresadas);
+        }
+        c.ultimo.store((MarcaTiempo)ingresadas, std::memory_order_relaxed);
+        if (reloj.segundos() >= limite) break;
+    }
+    double segundos = reloj.segundos();
+    c.detener.store(true);
+    for (int i = 0; i < numLectores; i++) lectores[i].join();
+    delete[] lectores;
+
+    printf("  %2d lectores: ingreso %7.2f M lecturas/s | agregarTotal %8.2f M/s | agregarRango %8.3f M/s\n",
+           numLectores, ingresadas / segundos / 1e6, c.totales.load() / segundos / 1e6,
+           c.rangos.load() / segundos / 1e6);
+}
+
+int main(int argc, char* argv[]) {
+    int maxLectores = (int)argumento(argc, argv, 1, 8);
+    long duracionMs = argumento(argc, argv, 2, 1000);
+    int retencion = (int)argumento(argc, argv, 3, 10000);
+
+    printf("HISTORIAL_CONCURRENTE, 1 escritor, retencion %d, %ld ms por ronda (%u hilos de hardware)\n",
+           retencion, duracionMs, std::thread::hardware_concurrency());
+    ronda(0, duracionMs, retencion);
+    for (int n = 1; n <= maxLectores; n *= 2) ronda(n, duracionMs, retencion);
+    return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file bench_exportar.cpp
+ * @brief Benchmark de Sistema::exportar() en formato columnar y CSV, en GB/s.
+ * @details Llena un Sistema con sensores de temperatura y presión en modo
+ * lista (sin compactación) y exporta todas sus lecturas con cada
+ * exportador, primero a /dev/null (costo de recorrer y formatear) y luego
+ * a un archivo real (incluye la escritura). El rendimiento se informa en
+ * bytes de salida por segundo y en lecturas por segundo.
+ *
+ * Uso: bench_exportar [lecturas_por_sensor=1000000] [sensores=4] [ruta=bench_exportar.tmp]
+ */
+
+#include "Sistema.h"
+#include "Exportador.h"
+#include "Cronometro.h"
+#include <cstdio>
+#include <unistd.h>
+
+/**
+ * @brief Exporta el sistema completo una vez e imprime su rendimiento.
+ * @return false si la exportación falló.
+ */
+static bool medir(const char* etiqueta, Exportador& exportador, Sistema& sistema, const char* ruta) {
+    Cronometro c;
+    if (!exportador.abrir(ruta) || !sistema.exportar(exportador)) return false;
+    double s = c.segundos();
+    uint64_t bytes = exportador.getBytesEscritos();
+    printf("  %-10s -> %-22s %8.1f MB  %6.3f s  %6.2f GB/s  %7.1f M lecturas/s\n",
+           etiqueta, ruta, bytes / 1e6, s, bytes / s / 1e9,
+           exportador.getTotalLecturas() / s / 1e6);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    long n = argumento(argc, argv, 1, 1000000);
+    long sensores = argumento(argc, argv, 2, 4);
+    const char* ruta = (argc > 3) ? argv[3] : "bench_exportar.tmp";
+
+    bool ok = true;
+    {
+        SilenciarCout silencio; // Los mensajes de alta y baja de sensores
+        Sistema sistema;
+        for (long k = 0; k < sensores; k++) {
+            char nombre[32];
+            snprintf(nombre, sizeof(nombre), "%s-%ld", (k % 2 == 0) ? "T" : "P", k);
+            if (k % 2 == 0) {
+                ManejadorSensor h = sistema.agregarSensor<SensorTemperatura>(nombre);
+                SensorTemperatura* sensor = static_cast<SensorTemperatura*>(sistema.obtenerSensor(h));
+                sensor->configurarRetencion(0);
+                for (long i = 0; i < n; i++) sensor->agregarLectura(temperaturaSimulada(i), (MarcaTiempo)i);
+            } else {
+                ManejadorSensor h = sistema.agregarSensor<SensorPresion>(nombre);
+                SensorPresion* sensor = static_cast<SensorPresion*>(sistema.obtenerSensor(h));
+                sensor->configurarRetencion(0);
+                for (long i = 0; i < n; i++) sensor->agregarLectura(presionSimulada(i), (MarcaTiempo)i);
+            }
+        }
+
+        printf("Exportacion de %ld sensores x %ld lecturas\n", sensores, n);
+        fflush(stdout);
+        const char* destinos[2] = { "/dev/null", ruta };
+        for (int d = 0; d < 2 && ok; d++) {
+            ExportadorColumnar columnar;
+            ok = medir("columnar", columnar, sistema, destinos[d]);
+            ExportadorCSV csv;
+            ok = ok && medir("csv", csv, sistema, destinos[d]);
+        }
+        fflush(stdout);
+    }
+    unlink(ruta);
+
+    if (!ok) {
+        fprintf(stderr, "Error [bench_exportar] fallo la exportacion\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file bench_minimo.cpp
+ * @brief Benchmark de procesarLectura() repetido sobre historiales de temperatura grandes.
+ * @details Compara la extracción del mínimo con el índice HeapMinimos
+ * (lo que usa SensorTemperatura) contra los recorridos lineales.
+ *
+ * Uso: bench_minimo [lecturas=1000000] [llamadas_indice=100000] [llamadas_lineal=20]
+ */
+
+#include "Sensor.h"
+#include "Cronometro.h"
+#include <cstdio>
+
+int main(int argc, char* argv[]) {
+    long n = argumento(argc, argv, 1, 1000000);
+    long llamadasIndice = argumento(argc, argv, 2, 100000);
+    long llamadasLineal = argumento(argc, argv, 3, 20);
+    if (llamadasIndice > n) llamadasIndice = n;
+    if (llamadasLineal > n) llamadasLineal = n;
+
+    // --- SensorTemperatura en modo lista: índice de mínimos, O(log n) ---
+    srand(1);
+    double porLlamadaIndice;
+    {
+        SensorTemperatura sensor("T-BENCH");
+        sensor.configurarRetencion(0); // Sin compactación: el historial conserva las n lecturas
+        for (long i = 0; i < n; i++) {
+            sensor.agregarLectura(temperaturaSimulada(i), (MarcaTiempo)i);
+        }
+        SilenciarCout silencio;
+        Cronometro c;
+        for (long k = 0; k < llamadasIndice; k++) {
+            sensor.procesarLectura();
+        }
+        porLlamadaIndice = c.segundos() / llamadasIndice;
+    }
+
+    // --- Línea base: buscar el mínimo y eliminarValor(), dos recorridos ---
+    srand(1);
+    ListaSensor<float> dosRecorridos;
+    for (long i = 0; i < n; i++) dosRecorridos.insertarAlFinal(temperaturaSimulada(i));
+    Cronometro c;
+    for (long k = 0; k < llamadasLineal; k++) {
+        dosRecorridos.eliminarValor(dosRecorridos.getMinimo()->dato);
+    }
+    double porLlamadaDos = c.segundos() / llamadasLineal;
+
+    // --- ListaSensor sin índice: extraerMinimo() en un recorrido ---
+    srand(1);
+    ListaSensor<float> unRecorrido;
+    for (long i = 0; i < n; i++) unRecorrido.insertarAlFinal(temperaturaSimulada(i));
+    c.reiniciar();
+    float minimo;
+    for (long k = 0; k < llamadasLineal; k++) {
+        unRecorrido.extraerMinimo(minimo);
+    }
+    double porLlamadaUno = c.segundos() / llamadasLineal;
+
+    printf("Historial de %ld lecturas float\n", n);
+    printf("  procesarLectura (indice HeapMinimos): %10.3f us/llamada (%ld llamadas)\n",
+           porLlamadaIndice * 1e6, llamadasIndice);
+    printf("  minimo + eliminarValor (2 recorridos): %10.3f us/llamada (%ld llamadas)\n",
+           porLlamadaDos * 1e6, llamadasLineal);
+    printf("  extraerMinimo sin indice (1 recorrido): %9.3f us/llamada (%ld llamadas)\n",
+           porLlamadaUno * 1e6, llamadasLineal);
+    printf("  aceleracion del indice: %.0fx\n", porLlamadaDos / porLlamadaIndice);
+    return 0;
+}
@@ -2,27 +2,48 @@
  * @file main.cpp
  * @brief Punto de entrada principal del programa y menú interactivo.
  * @details Gestiona la inicialización del Sistema y el puerto Serial,
- * y maneja el bucle principal del menú de usuario.
+ * y maneja el bucle principal del menú de usuario. Uso:
+ * - `monitor [puerto] [baudios]`: menú interactivo (por defecto /dev/ttyACM0 a 9600).
+ * - `monitor --demonio archivo.conf`: modo demonio, sin menú (ver Demonio).
  */
 
 #include <iostream>
 #include <limits> // Para limpiar el buffer de std::cin
+#include <cstdio> // Para snprintf
+#include <cstdlib> // Para atoi
+#include <cstring> // Para strcmp
 #include "Sistema.h"
 #include "Serial.h"
+#include "Exportador.h"
+#include "Demonio.h"
 
 // --- Prototipos de funciones del menú ---
 void mostrarMenu();
 void crearSensor(Sistema& sistema, bool esTemp);
 void registrarLectura(Sistema& sistema, Serial& port);
+void configurarAlerta(Sistema& sistema);
+void exportarHistoriales(Sistema& sistema);
+
+int main(int argc, char* argv[]) {
+    // --- Modo demonio: todo sale del archivo de configuración ---
+    if (argc >= 2 && strcmp(argv[1], "--demonio") == 0) {
+        if (argc != 3) {
+            std::cerr << "Uso: " << argv[0] << " --demonio archivo.conf" << std::endl;
+            return 1;
+        }
+        Demonio demonio;
+        if (!demonio.cargarConfiguracion(argv[2]) || !demonio.iniciar()) return 1;
+        return demonio.ejecutar();
+    }
 
-int main() {
     // --- Configuración del Puerto Serial ---
     Serial serial;
-    // IMPORTANTE: Cambia "/dev/ttyUSB0" por tu puerto si es diferente (ej. /dev/ttyACM0)
-    const char* puerto = "/dev/ttyACM0"; 
+    // Puerto y velocidad por argumento (ej. monitor /dev/ttyUSB0 115200)
+    const char* puerto = (argc >= 2) ? argv[1] : "/dev/ttyACM0";
+    int baudios = (argc >= 3) ? atoi(argv[2]) : 9600;
     
     std::cout << "Intentando conectar a Arduino en " << puerto << "..." << std::endl;
-    if (!serial.abrir(puerto, 9600)) {
+    if (!serial.abrir(puerto, baudios)) {
         std::cerr << "Error: No se pudo conectar al Arduino." << std::endl;
         std::cerr << "Asegurate de: \n1. Que este conectado.\n2. Que el puerto sea correcto.\n3. Que tengas permisos (sudo usermod -a -G dialout $USER y REINICIA SESION)." << std::endl;
         return 1;
@@ -34,6 +55,8 @@ int main() {
     // --- Inicio del Sistema ---
     Sistema sistema;
     int opcion = 0;
+    // Las alertas se imprimen en cuanto se registra la lectura que las dispara
+    sistema.getAlertas().configurarCallback(Sistema::imprimirAlerta, &sistema);
     
     std::cout << "\n--- Sistema IoT de Monitoreo Polimorfico ---" << std::endl;
 
@@ -67,10 +90,25 @@ int main() {
             case 5:
                 std::cout << "\nOpcion 5: Cerrar Sistema (Liberar Memoria)" << std::endl;
                 break;
+            case 6:
+                configurarAlerta(sistema);
+                break;
+            case 7:
+                exportarHistoriales(sistema);
+                break;
+            case 8:
+                std::cout << "Opcion 8: Ultimos Resultados" << std::endl;
+                sistema.imprimirResultados();
+                break;
             default:
                 std::cout << "Opcion invalida. Intente de nuevo." << std::endl;
                 break;
         }
+
+        // El callback ya las imprimió: se vacía la cola para que no se llene
+        // y getAlertasPerdidas() siga contando solo pérdidas reales
+        Alerta alerta;
+        while (sistema.getAlertas().siguienteAlerta(alerta)) {}
     }
 
     // Al salir del 'main', el destructor de 'sistema' se llama automáticamente,
@@ -89,6 +127,9 @@ void mostrarMenu() {
     std::cout << "3: Registrar Lectura (Desde Arduino)" << std::endl;
     std::cout << "4: Ejecutar Procesamiento Polimorfico" << std::endl;
     std::cout << "5: Cerrar Sistema (Liberar Memoria)" << std::endl;
+    std::cout << "6: Configurar Alerta (por tipo de sensor)" << std::endl;
+    std::cout << "7: Exportar Historiales (binario columnar y CSV)" << std::endl;
+    std::cout << "8: Ver Ultimos Resultados (sin reprocesar)" << std::endl;
     std::cout << "Seleccione una opcion: ";
 }
 
@@ -104,15 +145,27 @@ void crearSensor(Sistema& sistema, bool esTemp) {
     
     std::cin.getline(nombre, 50); // Leer C-string
 
-    SensorBase* nuevoSensor = nullptr;
+    int opcionModo = 1;
+    std::cout << "Modo de historial (1 = lista, 2 = comprimido, 3 = concurrente): ";
+    std::cin >> opcionModo;
+    if (std::cin.fail()) {
+        std::cin.clear();
+        opcionModo = 1; // Entrada inválida: modo lista
+    }
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+    ModoHistorial modo = HISTORIAL_LISTA;
+    if (opcionModo == 2) modo = HISTORIAL_COMPRIMIDO;
+    else if (opcionModo == 3) modo = HISTORIAL_CONCURRENTE;
+
+    // El sensor se construye directamente dentro del registro de gestión
     if (esTemp) {
-        nuevoSensor = new SensorTemperatura(nombre);
+        sistema.agregarSensor<SensorTemperatura>(nombre, modo);
     } else {
-        nuevoSensor = new SensorPresion(nombre);
+        sistema.agregarSensor<SensorPresion>(nombre, modo);
     }
     
-    sistema.agregarSensor(nuevoSensor);
-    std::cout << "Sensor '" << nombre << "' creado e insertado en la lista de gestion." << std::endl;
+    std::cout << "Sensor '" << nombre << "' creado e insertado en el registro de gestion." << std::endl;
 }
 
 void registrarLectura(Sistema& sistema, Serial& port) {
@@ -121,14 +174,60 @@ void registrarLectura(Sistema& sistema, Serial& port) {
     std::cout << "Ingrese ID del sensor para registrar lectura: ";
     std::cin.getline(id, 50);
 
-    SensorBase* sensor = sistema.buscarSensor(id);
+    ManejadorSensor h = sistema.buscarManejador(id);
 
-    if (sensor == nullptr) {
+    // El sensor espera el prefijo correcto (T: o P:) y el Sistema
+    // evalúa las alertas sobre la lectura recibida.
+    if (!sistema.registrarNuevaLectura(h, port)) {
         std::cout << "Error: Sensor con ID '" << id << "' no encontrado." << std::endl;
-    } else {
-        // Polimorfismo: Llama al método 'registrarNuevaLectura'
-        // apropiado (Temp o Presion).
-        // Ese método se encargará de esperar el prefijo correcto (T: o P:)
-        sensor->registrarNuevaLectura(port);
     }
-}
\ No newline at end of file
+}
+
+void configurarAlerta(Sistema& sistema) {
+    char tipo;
+    ReglaAlerta regla;
+    std::cout << "Opcion 6: Configurar Alerta" << std::endl;
+    std::cout << "Tipo de sensor (T = Temperatura, P = Presion): ";
+    std::cin >> tipo;
+    std::cout << "Minimo permitido: ";
+    std::cin >> regla.minimo;
+    std::cout << "Maximo permitido: ";
+    std::cin >> regla.maximo;
+    std::cout << "Cambio maximo por segundo (0 = sin limite): ";
+    std::cin >> regla.maxCambioPorSegundo;
+    std::cout << "Histeresis: ";
+    std::cin >> regla.histeresis;
+
+    if (std::cin.fail()) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Error: Valores invalidos, la alerta no se configuro." << std::endl;
+        return;
+    }
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+    sistema.definirAlertaTipo((tipo == 'P' || tipo == 'p') ? SENSOR_PRESION : SENSOR_TEMPERATURA, regla);
+    std::cout << "Alerta configurada." << std::endl;
+}
+
+void exportarHistoriales(Sistema& sistema) {
+    char base[200];
+    char ruta[210];
+    std::cout << "Opcion 7: Exportar Historiales" << std::endl;
+    std::cout << "Ingrese nombre base de los archivos (ej. lecturas): ";
+    std::cin.getline(base, 200);
+
+    ExportadorColumnar columnar;
+    snprintf(ruta, sizeof(ruta), "%s.monc", base);
+    if (columnar.abrir(ruta) && sistema.exportar(columnar)) {
+        std::cout << "Exportadas " << columnar.getTotalLecturas() << " lecturas a " << ruta
+                  << " (" << columnar.getBytesEscritos() << " bytes)." << std::endl;
+    }
+
+    ExportadorCSV csv;
+    snprintf(ruta, sizeof(ruta), "%s.csv", base);
+    if (csv.abrir(ruta) && sistema.exportar(csv)) {
+        std::cout << "Exportadas " << csv.getTotalLecturas() << " lecturas a " << ruta
+                  << " (" << csv.getBytesEscritos() << " bytes)." << std::endl;
+    }
+}
@@ -0,0 +1,147 @@
+/**
+ * @file prueba_concurrente.cpp
+ * @brief Prueba de estrés del modo HISTORIAL_CONCURRENTE (pensada para ThreadSanitizer).
+ * @details Fase 1: un escritor ingresa lecturas de valor 1 con una
+ * retención chica (compacta seguido) mientras varios lectores consultan sin
+ * locks. Como cada lectura vale 1, todo agregado debe tener suma igual a
+ * cantidad, y la cantidad que ve cada lector nunca puede bajar: si una
+ * lectura compactada se perdiera entre los rollups y la lista, bajaría.
+ * Fase 2: dos escritores (ingreso y extraerMinimo) contra los mismos
+ * lectores; al final la cantidad debe cuadrar exactamente.
+ *
+ * Uso: prueba_concurrente [lecturas=200000] [lectores=4]
+ */
+
+#include "Historial.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+/// @brief Lecturas crudas retenidas durante la prueba (compacta cada ~1024 ingresos).
+static const int RETENCION = 2000;
+
+/**
+ * @struct Estado
+ * @brief Datos compartidos entre los hilos de la prueba.
+ */
+struct Estado {
+    /// @brief El historial bajo prueba.
+    HistorialSensor<int> historial;
+    /// @brief Los escritores terminaron.
+    std::atomic<bool> terminado;
+    /// @brief Violaciones de invariantes detectadas por los lectores.
+    std::atomic<int> errores;
+    /// @brief Lecturas ingresadas hasta ahora (cota superior para los lectores).
+    std::atomic<long> ingresadas;
+    /// @brief La fase actual quita lecturas (la cantidad puede bajar).
+    bool conExtracciones;
+
+    Estado() : historial(HISTORIAL_CONCURRENTE), terminado(false), errores(0), ingresadas(0),
+               conExtracciones(false) {}
+};
+
+/**
+ * @brief Informa una violación y la cuenta.
+ */
+static void fallar(Estado& e, const char* mensaje, long valor, long esperado) {
+    if (e.errores.fetch_add(1) < 10) {
+        std::cerr << "Error [prueba_concurrente] " << mensaje << ": " << valor
+                  << " (esperado " << esperado << ")" << std::endl;
+    }
+}
+
+/**
+ * @brief Hilo lector: consulta sin parar y verifica las invariantes.
+ */
+static void lector(Estado* e) {
+    long ultimaRango = 0;
+    long ultimaTotal = 0;
+    while (!e->terminado.load()) {
+        long cota = e->ingresadas.load();
+        Agregado total = e->historial.agregarTotal();
+        Agregado rango = e->historial.agregarRango(0, (MarcaTiempo)-1);
+        if ((long)total.suma != total.cantidad) fallar(*e, "agregarTotal: suma distinta de cantidad", (long)total.suma, total.cantidad);
+        if ((long)rango.suma != rango.cantidad) fallar(*e, "agregarRango: suma distinta de cantidad", (long)rango.suma, rango.cantidad);
+        if (!e->conExtracciones) {
+            if (total.cantidad < ultimaTotal) fallar(*e, "agregarTotal retrocedio", total.cantidad, ultimaTotal);
+            if (rango.cantidad < ultimaRango) fallar(*e, "agregarRango retrocedio", rango.cantidad, ultimaRango);
+            if (total.cantidad < cota) fallar(*e, "agregarTotal perdio lecturas", total.cantidad, cota);
+            if (rango.cantidad < cota) fallar(*e, "agregarRango perdio lecturas", rango.cantidad, cota);
+            ultimaTotal = total.cantidad;
+            ultimaRango = rango.cantidad;
+        }
+        if (e->historial.getTamano() < 0 || e->historial.bytesUsados() <= 0) {
+            fallar(*e, "getTamano/bytesUsados invalidos", e->historial.getTamano(), 0);
+        }
+        e->historial.getSuma();
+    }
+}
+
+/**
+ * @brief Hilo escritor: ingresa `n` lecturas de valor 1 a partir de la marca `t0`.
+ */
+static void escritor(Estado* e, long t0, long n) {
+    for (long i = 0; i < n; i++) {
+        e->historial.agregar(1, (MarcaTiempo)(t0 + i));
+        e->ingresadas.fetch_add(1);
+    }
+}
+
+/**
+ * @brief Hilo que extrae mínimos hasta que el escritor termina.
+ * @param extraidas Recibe cuántas lecturas quitó.
+ */
+static void extractor(Estado* e, std::atomic<bool>* escritorListo, long* extraidas) {
+    int valor;
+    long n = 0;
+    while (!escritorListo->load()) {
+        if (e->historial.extraerMinimo(valor)) n++;
+        std::this_thread::yield();
+    }
+    *extraidas = n;
+}
+
+int main(int argc, char* argv[]) {
+    long n = (argc > 1) ? atol(argv[1]) : 200000;
+    int numLectores = (argc > 2) ? atoi(argv[2]) : 4;
+    Estado e;
+    e.historial.configurarRetencion(RETENCION);
+
+    // --- Fase 1: un escritor, lectores verificando monotonía ---
+    std::thread* lectores = new std::thread[numLectores];
+    for (int i = 0; i < numLectores; i++) lectores[i] = std::thread(lector, &e);
+    escritor(&e, 0, n);
+    e.terminado.store(true);
+    for (int i = 0; i < numLectores; i++) lectores[i].join();
+
+    Agregado total = e.historial.agregarTotal();
+    if (total.cantidad != n) fallar(e, "fase 1: cantidad final", total.cantidad, n);
+
+    // --- Fase 2: ingreso y extraerMinimo desde hilos distintos ---
+    e.conExtracciones = true;
+    e.terminado.store(false);
+    for (int i = 0; i < numLectores; i++) lectores[i] = std::thread(lector, &e);
+    std::atomic<bool> escritorListo(false);
+    long extraidas = 0;
+    std::thread hiloExtractor(extractor, &e, &escritorListo, &extraidas);
+    escritor(&e, n, n / 4);
+    escritorListo.store(true);
+    hiloExtractor.join();
+    e.terminado.store(true);
+    for (int i = 0; i < numLectores; i++) lectores[i].join();
+    delete[] lectores;
+
+    total = e.historial.agregarTotal();
+    long esperado = n + n / 4 - extraidas;
+    if (total.cantidad != esperado) fallar(e, "fase 2: cantidad final", total.cantidad, esperado);
+    if ((long)total.suma != esperado) fallar(e, "fase 2: suma final", (long)total.suma, esperado);
+
+    if (e.errores.load() > 0) {
+        std::cerr << "Error [prueba_concurrente] " << e.errores.load() << " fallas." << std::endl;
+        return 1;
+    }
+    std::cout << "prueba_concurrente: OK (" << n + n / 4 << " lecturas, " << extraidas
+              << " extraidas, " << numLectores << " lectores)" << std::endl;
+    return 0;
+}